@@ -1,10 +1,10 @@
-#ifndef IDESTROYABLE_H
-#define IDESTROYABLE_H
-
-class iDestroyable
-{
-public:
-    virtual void destroy() = 0;
-};
-
-#endif // IDESTROYABLE_H
+#ifndef IDESTROYABLE_H
+#define IDESTROYABLE_H
+
+class iDestroyable
+{
+public:
+    virtual void destroy() = 0;
+};
+
+#endif // IDESTROYABLE_H
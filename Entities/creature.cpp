@@ -1,13 +1,13 @@
-#include "creature.h"
-
-
-Creature::Creature(QGraphicsItem *parent)
-    : Entity(parent)
-{
-
-}
-
-Creature::~Creature()
-{
-
-}
+#include "creature.h"
+
+
+Creature::Creature(QGraphicsItem *parent)
+    : Entity(parent)
+{
+
+}
+
+Creature::~Creature()
+{
+
+}
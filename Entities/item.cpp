@@ -1,12 +1,12 @@
-#include "item.h"
-
-Item::Item(QGraphicsItem *parent)
-    : Entity(parent)
-{
-
-}
-
-Item::~Item()
-{
-
-}
+#include "item.h"
+
+Item::Item(QGraphicsItem *parent)
+    : Entity(parent)
+{
+
+}
+
+Item::~Item()
+{
+
+}
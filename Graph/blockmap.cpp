@@ -0,0 +1,28 @@
+#include "blockmap.h"
+
+BlockMap::BlockMap(int capacity)
+{
+    reset(capacity);
+}
+
+BlockMap::~BlockMap()
+{
+
+}
+
+void BlockMap::reset(int capacity)
+{
+    m_blockOf.fill(-1, (capacity + BLOCK_SIZE - 1) >> BLOCK_SHIFT);
+    m_firstOf.clear();
+    m_capacity = capacity;
+}
+
+int BlockMap::capacity() const
+{
+    return m_capacity;
+}
+
+int BlockMap::slotCount() const
+{
+    return m_firstOf.size() << BLOCK_SHIFT;
+}
@@ -0,0 +1,64 @@
+#ifndef BLOCKMAP_H
+#define BLOCKMAP_H
+
+#include <QVector>
+
+// BlockMap gives the slots of per-index data for indices in range [0, capacity), so that the data for the big range
+// is not allocated at once: slots are given by blocks of BLOCK_SIZE consecutive indices at the first use of the block.
+// The owner keeps its per-index data in vectors of slotCount() elements and resizes them, when a new block is allocated.
+// Blocks are kept until reset, so the data, that is reused by many searches, is allocated only once.
+class BlockMap
+{
+public:
+    static constexpr int BLOCK_SHIFT = 12;
+    static constexpr int BLOCK_SIZE  = 1 << BLOCK_SHIFT;
+
+    BlockMap(int capacity = 0);
+    ~BlockMap();
+
+    // Forgets all the blocks and prepares the map for indices in range [0, capacity).
+    void reset (int capacity);
+
+    int capacity  () const;
+    int slotCount () const;
+
+    // Slot of the {index} or -1, if its block was never allocated.
+    int slotOf   (int index) const;
+    // Slot of the {index}, allocating its block at the end of the slots, if needed.
+    int allocate (int index);
+    // Index, that owns the {slot}.
+    int indexOf  (int slot) const;
+
+private:
+    // {m_blockOf} maps every block of indices to its place among the slots (-1, if it was never allocated),
+    // {m_firstOf} holds the first index of every allocated block in the order of allocation.
+    QVector<int> m_blockOf;
+    QVector<int> m_firstOf;
+    int          m_capacity = 0;
+};
+
+// Queues and the search space take the slot at every step, so it is inline.
+inline int BlockMap::slotOf(int index) const
+{
+    int block = m_blockOf.at(index >> BLOCK_SHIFT);
+    return block == -1 ? -1 : (block << BLOCK_SHIFT) | (index & (BLOCK_SIZE - 1));
+}
+
+inline int BlockMap::allocate(int index)
+{
+    int slot = slotOf(index);
+    if (slot != -1)
+        return slot;
+
+    m_blockOf[index >> BLOCK_SHIFT] = m_firstOf.size();
+    m_firstOf.push_back(index & ~(BLOCK_SIZE - 1));
+
+    return slotOf(index);
+}
+
+inline int BlockMap::indexOf(int slot) const
+{
+    return m_firstOf.at(slot >> BLOCK_SHIFT) | (slot & (BLOCK_SIZE - 1));
+}
+
+#endif // BLOCKMAP_H
@@ -0,0 +1,196 @@
+#include "bucketqueue.h"
+
+BucketQueue::BucketQueue(int capacity, int maxStep)
+{
+    setMaxStep(maxStep);
+    reset(capacity);
+}
+
+BucketQueue::~BucketQueue()
+{
+
+}
+
+void BucketQueue::reset(int capacity)
+{
+    m_slots.reset(capacity);
+    m_next.clear();
+    m_prev.clear();
+    m_priority.clear();
+    m_bucketOf.clear();
+
+    m_head.fill(-1);
+    m_overflow.reset(capacity);
+    m_lowest  = 0;
+    m_highest = 0;
+    m_size    = 0;
+}
+
+// Window of priorities is {maxStep + 1} buckets wide. Changing it clears the queue.
+void BucketQueue::setMaxStep(int maxStep)
+{
+    if (maxStep < 1)
+        maxStep = 1;
+
+    if (maxStep > MAX_STEP)
+        maxStep = MAX_STEP;
+
+    if (m_head.size() == maxStep + 1)
+        return;
+
+    clear();
+    m_head.fill(-1, maxStep + 1);
+}
+
+// Forgets all the queued indices. Costs O(size + buckets), not O(capacity).
+void BucketQueue::clear()
+{
+    for (int bucket = 0; bucket < m_head.size(); ++bucket)
+    {
+        for (int slot = m_head[bucket]; slot != -1; slot = m_next[slot])
+            m_bucketOf[slot] = -1;
+
+        m_head[bucket] = -1;
+    }
+
+    m_overflow.clear();
+    m_lowest  = 0;
+    m_highest = 0;
+    m_size    = 0;
+}
+
+int BucketQueue::size() const
+{
+    return m_size + m_overflow.size();
+}
+
+int BucketQueue::capacity() const
+{
+    return m_slots.capacity();
+}
+
+int BucketQueue::maxStep() const
+{
+    return m_head.size() - 1;
+}
+
+bool BucketQueue::isEmpty() const
+{
+    return m_size == 0 && m_overflow.isEmpty();
+}
+
+bool BucketQueue::contains(int index) const
+{
+    int slot = m_slots.slotOf(index);
+    return (slot != -1 && m_bucketOf[slot] != -1) || m_overflow.contains(index);
+}
+
+qint64 BucketQueue::priorityOf(int index) const
+{
+    if (m_overflow.contains(index))
+        return m_overflow.priorityOf(index);
+
+    return m_priority[m_slots.slotOf(index)];
+}
+
+void BucketQueue::push(int index, qint64 priority)
+{
+    // Empty buckets may take the window anywhere. Otherwise it moves up only when indices are popped,
+    // and it moves down only as far, as the highest priority in buckets stays inside it.
+    if (m_size == 0)
+        m_lowest = m_highest = priority;
+    else if (priority < m_lowest && m_highest - priority <= maxStep())
+        m_lowest = priority;
+
+    bool fits = priority >= m_lowest && priority - m_lowest <= maxStep();
+    if (fits)
+        m_highest = qMax(m_highest, priority);
+
+    // New block of indices gets its links, none of them is queued yet.
+    int slot = m_slots.allocate(index);
+    if (slot >= m_bucketOf.size())
+    {
+        m_next.resize(m_slots.slotCount());
+        m_prev.resize(m_slots.slotCount());
+        m_priority.resize(m_slots.slotCount());
+        m_bucketOf += QVector<int>(BlockMap::BLOCK_SIZE, -1);
+    }
+
+    if (m_bucketOf[slot] != -1)
+        unlink(slot);
+
+    // Priority outside the window would share the bucket with the ones from the window and break their order.
+    if (!fits)
+    {
+        m_overflow.push(index, priority);
+        return;
+    }
+
+    m_overflow.remove(index);
+    m_priority[slot] = priority;
+    link(slot, bucketFor(priority));
+}
+
+int BucketQueue::pop()
+{
+    // Move the window up to the first non-empty bucket.
+    if (m_size > 0)
+        while (m_head[bucketFor(m_lowest)] == -1)
+            ++m_lowest;
+
+    // Heap goes first, when its top is lower than the first non-empty bucket.
+    if (m_size == 0 || (!m_overflow.isEmpty() && m_overflow.topPriority() < m_lowest))
+        return m_overflow.pop();
+
+    int slot = m_head[bucketFor(m_lowest)];
+    unlink(slot);
+
+    return m_slots.indexOf(slot);
+}
+
+void BucketQueue::remove(int index)
+{
+    int slot = m_slots.slotOf(index);
+    if (slot != -1 && m_bucketOf[slot] != -1)
+        unlink(slot);
+
+    m_overflow.remove(index);
+}
+
+int BucketQueue::bucketFor(qint64 priority) const
+{
+    return int(priority % m_head.size());
+}
+
+// Places {slot} at the front of the {bucket}.
+void BucketQueue::link(int slot, int bucket)
+{
+    int head = m_head[bucket];
+
+    m_next[slot] = head;
+    m_prev[slot] = -1;
+    if (head != -1)
+        m_prev[head] = slot;
+
+    m_head[bucket]   = slot;
+    m_bucketOf[slot] = bucket;
+    ++m_size;
+}
+
+void BucketQueue::unlink(int slot)
+{
+    int bucket = m_bucketOf[slot];
+    int next   = m_next[slot];
+    int prev   = m_prev[slot];
+
+    if (prev != -1)
+        m_next[prev] = next;
+    else
+        m_head[bucket] = next;
+
+    if (next != -1)
+        m_prev[next] = prev;
+
+    m_bucketOf[slot] = -1;
+    --m_size;
+}
@@ -0,0 +1,66 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <QVector>
+
+#include "blockmap.h"
+#include "priorityqueue.h"
+
+// BucketQueue is a priority queue for small integer weights (Dial's algorithm).
+// Our tiles cost from 0 to 9 action points, so all the queued priorities lie in the window [lowest, lowest + maxStep].
+// Every priority of that window has its own bucket (the list of queued indices), and buckets are reused in a circle.
+// Push, decrease-key and remove are O(1), pop moves to the next non-empty bucket, which is at most maxStep buckets away.
+// Priorities are expected to stay in the window (that is true for Dijkstra search and A* with consistent heuristic).
+// The ones, that don't, are kept in the binary heap aside, so they are still popped in order, just slower.
+// Interface is the same as the one of PriorityQueue, so both of them can be used by the search.
+// Links of the indices are kept by blocks (see BlockMap), as positions of the PriorityQueue are.
+class BucketQueue
+{
+public:
+    static constexpr int MAX_STEP = 1024;
+    BucketQueue(int capacity = 0, int maxStep = 1);
+    ~BucketQueue();
+
+    // Prepares the queue for indices in range [0, capacity) and steps up to {maxStep}. Clears the queue.
+    void reset      (int capacity);
+    void setMaxStep (int maxStep);
+    void clear      ();
+
+    int  size     () const;
+    int  capacity () const;
+    int  maxStep  () const;
+    bool isEmpty  () const;
+    bool contains (int index) const;
+
+    qint64 priorityOf (int index) const;
+
+    // Inserts {index} with given {priority} or changes the priority of already queued {index}.
+    // Index, that is pushed later, is popped earlier among the ones with equal priority inside the window.
+    void push   (int index, qint64 priority);
+    int  pop    ();
+    void remove (int index);
+
+private:
+    int  bucketFor (qint64 priority) const;
+    void link      (int slot, int bucket);
+    void unlink    (int slot);
+
+    // Every bucket is a doubly-linked list of the slots of indices: {m_head} holds the first slot of each bucket,
+    // {m_next} and {m_prev} link the slots within the bucket, {m_bucketOf} is -1 for slots, that are not queued.
+    BlockMap        m_slots;
+    QVector<int>    m_head;
+    QVector<int>    m_next;
+    QVector<int>    m_prev;
+    QVector<int>    m_bucketOf;
+    QVector<qint64> m_priority;
+
+    // Indices with priorities outside the window.
+    PriorityQueue   m_overflow;
+
+    // {m_highest} is the highest priority, that was pushed to buckets since they were empty, {m_size} counts the indices in buckets only.
+    qint64 m_lowest  = 0;
+    qint64 m_highest = 0;
+    int    m_size    = 0;
+};
+
+#endif // BUCKETQUEUE_H
@@ -0,0 +1,260 @@
+#include "compactgraph.h"
+#include "graph.h"
+#include "tree.h"
+#include "priorityqueue.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+CompactGraph::CompactGraph()
+{
+    m_offsets.push_back(0);
+}
+
+CompactGraph::CompactGraph(const Graph &graph)
+{
+    // 1. Give every node of the graph its index.
+    // 2. Count outgoing edges of each node, so that we know where its range of edges starts.
+    // 3. Place every edge to the free slot of its range.
+    // Edges, that refer to unknown nodes, are skipped.
+
+    reserve(graph.nodes().size(), graph.edges().size());
+
+    foreach (Node node, graph.nodes())
+    {
+        m_index.insert(node.id(), m_nodes.size());
+        m_nodes.push_back(node);
+    }
+
+    m_offsets.fill(0, m_nodes.size() + 1);
+    foreach (Edge edge, graph.edges())
+        if (contains(edge.from()) && contains(edge.to()))
+            ++m_offsets[indexOf(edge.from()) + 1];
+
+    for (int i = 0; i < m_nodes.size(); ++i)
+        m_offsets[i + 1] += m_offsets[i];
+
+    m_targets.resize(m_offsets.last());
+    m_weights.resize(m_offsets.last());
+    m_ends      = m_offsets.mid(1);
+    m_edgeCount = m_offsets.last();
+
+    QVector<int> free_slot = m_offsets;
+    foreach (Edge edge, graph.edges())
+    {
+        if (!contains(edge.from()) || !contains(edge.to()))
+            continue;
+
+        int slot = free_slot[indexOf(edge.from())]++;
+        m_targets[slot] = indexOf(edge.to());
+        m_weights[slot] = edge.weight();
+    }
+}
+
+CompactGraph::~CompactGraph()
+{
+
+}
+
+void CompactGraph::reserve(int nodes, int edges)
+{
+    m_nodes.reserve(nodes);
+    m_index.reserve(nodes);
+    m_offsets.reserve(nodes + 1);
+    m_ends.reserve(nodes);
+    m_targets.reserve(edges);
+    m_weights.reserve(edges);
+}
+
+// Appends the node with the next index. Edges, appended after it, are its outgoing edges.
+int CompactGraph::appendNode(const Node &node)
+{
+    m_index.insert(node.id(), m_nodes.size());
+    m_nodes.push_back(node);
+    m_offsets.push_back(m_offsets.last());
+    m_ends.push_back(m_offsets.last());
+
+    return m_nodes.size() - 1;
+}
+
+// Appends the edge from the last appended node to the node with index {to}.
+void CompactGraph::appendEdge(int to, int weight)
+{
+    m_targets.push_back(to);
+    m_weights.push_back(weight);
+    ++m_offsets.last();
+    ++m_ends.last();
+    ++m_edgeCount;
+}
+
+// Appends {count} unused edge slots to the last appended node.
+void CompactGraph::appendFreeSlots(int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        m_targets.push_back(-1);
+        m_weights.push_back(0);
+    }
+
+    m_offsets.last() += count;
+}
+
+int CompactGraph::edgeCapacity(int index) const
+{
+    return m_offsets[index + 1] - m_offsets[index];
+}
+
+bool CompactGraph::setEdges(int index, const int *targets, const int *weights, int count)
+{
+    if (count > edgeCapacity(index))
+        return false;
+
+    int begin = m_offsets[index];
+    for (int i = 0; i < count; ++i)
+    {
+        m_targets[begin + i] = targets[i];
+        m_weights[begin + i] = weights[i];
+    }
+
+    m_edgeCount += count - (m_ends[index] - begin);
+    m_ends[index] = begin + count;
+
+    return true;
+}
+
+int CompactGraph::nodeCount() const
+{
+    return m_nodes.size();
+}
+
+int CompactGraph::edgeCount() const
+{
+    return m_edgeCount;
+}
+
+bool CompactGraph::contains(const Node &node) const
+{
+    return m_index.contains(node.id());
+}
+
+int CompactGraph::indexOf(const Node &node) const
+{
+    return m_index.value(node.id(), -1);
+}
+
+const Node &CompactGraph::nodeAt(int index) const
+{
+    return m_nodes.at(index);
+}
+
+int CompactGraph::edgesBegin(int index) const
+{
+    return m_offsets[index];
+}
+
+int CompactGraph::edgesEnd(int index) const
+{
+    return m_ends[index];
+}
+
+int CompactGraph::target(int edge) const
+{
+    return m_targets[edge];
+}
+
+int CompactGraph::weight(int edge) const
+{
+    return m_weights[edge];
+}
+
+QVector<Node> CompactGraph::shortestPath(const Node &from, const Node &to) const
+{
+    QVector<Node> result;
+
+    int root   = indexOf(from);
+    int target = indexOf(to);
+    if (root == -1 || target == -1)
+        return result;
+
+    // There is no need to pick the nodes, that are further than {to}, so the search stops right at it.
+    QVector<int> weight;
+    QVector<int> parent;
+    QVector<int> picked = search(root, target, weight, parent);
+
+    if (picked.isEmpty() || picked.last() != target)
+    {
+        qDebug() << QString("Shortest path. Node %1 can't be reached from node %2.").arg(to.toString()).arg(from.toString());
+        return result;
+    }
+
+    for (int node = target; node != -1; node = parent[node])
+        result.push_back(nodeAt(node));
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+// Returns SPT with the {root} node, which holds all the nodes, that can be reached from the root.
+Tree CompactGraph::shortestPathTree(const Node &root) const
+{
+    int root_index = indexOf(root);
+    if (root_index == -1)
+        return Tree(root);
+
+    QVector<int> weight;
+    QVector<int> parent;
+    QVector<int> picked = search(root_index, -1, weight, parent);
+
+    // Weight of the edge between parent and its child is the difference of their weights.
+    Tree result (root);
+    foreach (int node, picked)
+        if (node != root_index)
+            result.addChildNodeTo(nodeAt(parent[node]), nodeAt(node), weight[node] - weight[parent[node]]);
+
+    qDebug() << "Shortest path. SPT has been built.";
+
+    return result;
+}
+
+QVector<int> CompactGraph::search(int root, int goal, QVector<int> &weight, QVector<int> &parent) const
+{
+    // 1. Mark all the nodes as unreached (weight -1) and put the root into priority queue.
+    // 2. While the queue has any node:
+    //    - Pop the node with the lowest weight. Its weight is final now. If it is the goal, we are done.
+    //    - Update weights of all its neighbours, remembering the node, that gave the neighbour its weight.
+    // Unreachable nodes never get into the queue, so the search ends, when all the reachable ones are picked.
+
+    QVector<int> picked;
+
+    weight.fill(-1, nodeCount());
+    parent.fill(-1, nodeCount());
+
+    PriorityQueue queue (nodeCount());
+    weight[root] = 0;
+    queue.push(root, 0);
+
+    while (!queue.isEmpty())
+    {
+        int node = queue.pop();
+        picked.push_back(node);
+
+        if (node == goal)
+            break;
+
+        for (int edge = edgesBegin(node); edge < edgesEnd(node); ++edge)
+        {
+            int neighbour  = target(edge);
+            int new_weight = weight[node] + m_weights[edge];
+
+            if (weight[neighbour] != -1 && (!queue.contains(neighbour) || new_weight >= weight[neighbour]))
+                continue;
+
+            weight[neighbour] = new_weight;
+            parent[neighbour] = node;
+            queue.push(neighbour, new_weight);
+        }
+    }
+
+    return picked;
+}
@@ -0,0 +1,72 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include <QVector>
+#include <QHash>
+
+#include "node.h"
+
+class Graph;
+class Tree;
+
+// CompactGraph is read-only form of the graph, that is used by SPT algorithm (compressed sparse row).
+// Every node has its index. Outgoing edges of all the nodes are stored one after another in two plain arrays (targets and weights),
+// and the node {i} owns the edges in range [edgesBegin(i), edgesEnd(i)). So the neighbours of the node are iterated directly,
+// without looking through all the edges of the graph. Each edge takes only two integers.
+//
+// The graph is either packed from {Graph} or appended node by node (f.e. by Grid):
+// nodes must be appended in order of their indices, each one followed by its outgoing edges.
+//
+// Node may also get free edge slots after its edges. Then its edges can be replaced in place (setEdges), as long as
+// they fit into the range of the node, so a small change of the graph doesn't need the graph to be built again.
+class CompactGraph
+{
+public:
+    CompactGraph();
+    CompactGraph(const Graph& graph);
+    ~CompactGraph();
+
+    void reserve    (int nodes, int edges);
+    int  appendNode (const Node& node);
+    void appendEdge (int to, int weight);
+    void appendFreeSlots (int count);
+
+    // Replaces outgoing edges of the node. Returns false, if they don't fit into its range.
+    int  edgeCapacity (int index) const;
+    bool setEdges     (int index, const int* targets, const int* weights, int count);
+
+    int nodeCount() const;
+    int edgeCount() const;
+
+    bool        contains (const Node& node) const;
+    int         indexOf  (const Node& node) const;
+    const Node& nodeAt   (int index) const;
+
+    int edgesBegin (int index) const;
+    int edgesEnd   (int index) const;
+    int target     (int edge) const;
+    int weight     (int edge) const;
+
+    // Shortest path is restored by walking from {to} back to {from} through remembered parents.
+    // SPT holds the same data in the form of tree, it is useful to look at the whole search result (f.e. for debugging).
+    QVector<Node> shortestPath     (const Node& from, const Node& to) const;
+    Tree          shortestPathTree (const Node& root) const;
+
+private:
+    // Dijkstra algorithm. Fills weight (-1 for unreached nodes) and parent (-1 for the root) of every node.
+    // Stops as soon as the {goal} node is picked (pass -1 to pick all the reachable nodes) or when there is nothing left to pick.
+    // Returns indices of picked nodes in order they were picked.
+    QVector<int> search (int root, int goal, QVector<int>& weight, QVector<int>& parent) const;
+
+    QVector<Node>   m_nodes;
+    QHash<NodeId,int> m_index;
+
+    // Node {i} owns slots [m_offsets[i], m_offsets[i + 1]), its edges are in [m_offsets[i], m_ends[i]).
+    QVector<int> m_offsets;
+    QVector<int> m_ends;
+    QVector<int> m_targets;
+    QVector<int> m_weights;
+    int          m_edgeCount = 0;
+};
+
+#endif // COMPACTGRAPH_H
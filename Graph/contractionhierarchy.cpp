@@ -0,0 +1,519 @@
+#include "contractionhierarchy.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+ContractionHierarchy::ContractionHierarchy()
+{
+
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+{
+
+}
+
+void ContractionHierarchy::build(const CompactGraph &graph)
+{
+    // 1. Copy edges of the graph into arcs (parallel edges are merged into the lightest one, loops are dropped).
+    // 2. Order nodes by their priority. Priority of the picked node is recomputed before its contraction (lazy update):
+    //    if it isn't the lowest one anymore, the node goes back to the queue.
+    // 3. Contract the node, give it the next rank and update priorities of its neighbours.
+    // 4. Split arcs into upward ones (to the higher node) and downward ones, so that the query walks only upwards.
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+    m_graph = graph;
+
+    int count = m_graph.nodeCount();
+    m_outgoing.fill(QVector<int>(), count);
+    m_incoming.fill(QVector<int>(), count);
+    m_contractedNeighbours.fill(0, count);
+    m_rank.fill(-1, count);
+
+    for (int k = 0; k < 2; ++k)
+    {
+        m_cost[k].fill(0, count);
+        m_parent[k].fill(-1, count);
+        m_stamp[k].fill(0, count);
+        m_open[k].reset(count);
+    }
+    m_currentStamp = 0;
+
+    for (int node = 0; node < count; ++node)
+        for (int edge = m_graph.edgesBegin(node); edge < m_graph.edgesEnd(node); ++edge)
+            if (m_graph.target(edge) != node)
+                addArc(node, m_graph.target(edge), m_graph.weight(edge), -1, -1);
+
+    PriorityQueue order (count);
+    for (int node = 0; node < count; ++node)
+        order.push(node, contract(node, true));
+
+    int rank = 0;
+    while (!order.isEmpty())
+    {
+        int node = order.pop();
+        int priority = contract(node, true);
+        if (!order.isEmpty() && priority > order.topPriority())
+        {
+            order.push(node, priority);
+            continue;
+        }
+
+        QVector<int> neighbours;
+        foreach (int arc, m_incoming[node])
+            neighbours.push_back(m_arcs[arc].from);
+        foreach (int arc, m_outgoing[node])
+            neighbours.push_back(m_arcs[arc].to);
+
+        contract(node, false);
+        m_rank[node] = rank++;
+
+        foreach (int neighbour, neighbours)
+            if (m_rank[neighbour] == -1)
+                order.push(neighbour, contract(neighbour, true));
+    }
+
+    m_upOffsets.fill(0, count + 1);
+    m_downOffsets.fill(0, count + 1);
+    foreach (const Arc& arc, m_arcs)
+    {
+        if (m_rank[arc.from] < m_rank[arc.to])
+            ++m_upOffsets[arc.from + 1];
+        else
+            ++m_downOffsets[arc.to + 1];
+
+        if (arc.first != -1)
+            ++m_shortcutCount;
+    }
+
+    for (int node = 0; node < count; ++node)
+    {
+        m_upOffsets[node + 1]   += m_upOffsets[node];
+        m_downOffsets[node + 1] += m_downOffsets[node];
+    }
+
+    m_up.resize(m_upOffsets.last());
+    m_down.resize(m_downOffsets.last());
+
+    QVector<int> up_slot   = m_upOffsets;
+    QVector<int> down_slot = m_downOffsets;
+    for (int arc = 0; arc < m_arcs.size(); ++arc)
+    {
+        if (m_rank[m_arcs[arc].from] < m_rank[m_arcs[arc].to])
+            m_up[up_slot[m_arcs[arc].from]++] = arc;
+        else
+            m_down[down_slot[m_arcs[arc].to]++] = arc;
+    }
+
+    // Contraction data is needed only by the build.
+    m_outgoing.clear();
+    m_incoming.clear();
+    m_contractedNeighbours.clear();
+
+    qDebug() << QString("Shortest path. Contraction hierarchy was built: %1 nodes, %2 edges, %3 shortcuts in %4 ms.")
+                .arg(count).arg(m_graph.edgeCount()).arg(m_shortcutCount).arg(timer.elapsed());
+}
+
+void ContractionHierarchy::clear()
+{
+    m_graph = CompactGraph();
+    m_arcs.clear();
+    m_rank.clear();
+    m_shortcutCount = 0;
+
+    m_upOffsets.clear();
+    m_up.clear();
+    m_downOffsets.clear();
+    m_down.clear();
+
+    m_pathCost = -1;
+    m_settledCount = 0;
+}
+
+bool ContractionHierarchy::isEmpty() const
+{
+    return m_rank.isEmpty();
+}
+
+int ContractionHierarchy::nodeCount() const
+{
+    return m_rank.size();
+}
+
+int ContractionHierarchy::shortcutCount() const
+{
+    return m_shortcutCount;
+}
+
+const CompactGraph &ContractionHierarchy::graph() const
+{
+    return m_graph;
+}
+
+QVector<Node> ContractionHierarchy::shortestPath(const Node &from, const Node &to)
+{
+    // Both searches go upwards, taking turns. The best path is the lightest sum of costs at the node, reached by both searches.
+    // Search of one side stops, when its lightest open node is not lighter than the best path: going further only adds weight.
+
+    QVector<Node> result;
+    m_pathCost = -1;
+    m_settledCount = 0;
+
+    int start = m_graph.indexOf(from);
+    int goal  = m_graph.indexOf(to);
+    if (isEmpty() || start == -1 || goal == -1)
+        return result;
+
+    nextStamp();
+    m_open[0].clear();
+    m_open[1].clear();
+
+    reach(0, start, 0, -1);
+    reach(1, goal,  0, -1);
+    m_open[0].push(start, 0);
+    m_open[1].push(goal,  0);
+
+    int meeting = -1;
+    bool searching = true;
+    while (searching)
+    {
+        searching = false;
+        for (int side = 0; side < 2; ++side)
+        {
+            PriorityQueue& open = m_open[side];
+            if (open.isEmpty())
+                continue;
+
+            if (m_pathCost != -1 && open.topPriority() >= m_pathCost)
+            {
+                open.clear();
+                continue;
+            }
+
+            searching = true;
+            int node = open.pop();
+            ++m_settledCount;
+
+            if (isReached(1 - side, node))
+            {
+                int cost = m_cost[0][node] + m_cost[1][node];
+                if (m_pathCost == -1 || cost < m_pathCost)
+                {
+                    m_pathCost = cost;
+                    meeting    = node;
+                }
+            }
+
+            const QVector<int>& offsets = side == 0 ? m_upOffsets : m_downOffsets;
+            const QVector<int>& arcs    = side == 0 ? m_up        : m_down;
+            for (int i = offsets[node]; i < offsets[node + 1]; ++i)
+            {
+                const Arc& arc = m_arcs[arcs[i]];
+                int next = side == 0 ? arc.to : arc.from;
+                int cost = m_cost[side][node] + arc.weight;
+
+                if (isReached(side, next) && cost >= m_cost[side][next])
+                    continue;
+
+                reach(side, next, cost, arcs[i]);
+                open.push(next, cost);
+            }
+        }
+    }
+
+    if (meeting == -1)
+    {
+        qDebug() << QString("Shortest path. Node %1 can't be reached from node %2.").arg(to.toString()).arg(from.toString());
+        return result;
+    }
+
+    // Forward half is restored from the meeting node back to the start, backward half goes from the meeting node to the goal.
+    QVector<int> forward;
+    for (int node = meeting; m_parent[0][node] != -1; node = m_arcs[m_parent[0][node]].from)
+        forward.push_back(m_parent[0][node]);
+
+    std::reverse(forward.begin(), forward.end());
+
+    result.push_back(m_graph.nodeAt(start));
+    foreach (int arc, forward)
+        unpack(arc, result);
+
+    for (int node = meeting; m_parent[1][node] != -1; node = m_arcs[m_parent[1][node]].to)
+        unpack(m_parent[1][node], result);
+
+    return result;
+}
+
+int ContractionHierarchy::pathCost() const
+{
+    return m_pathCost;
+}
+
+int ContractionHierarchy::settledCount() const
+{
+    return m_settledCount;
+}
+
+ContractionHierarchy::Benchmark ContractionHierarchy::benchmark(int queries, uint seed)
+{
+    // Queries are made between random nodes, that have any edges (filled cells of the grid are skipped).
+    // Every pair is answered by Dijkstra search first and then by the hierarchy, both paths must cost the same.
+
+    Benchmark result;
+
+    QVector<int> candidates;
+    for (int node = 0; node < m_graph.nodeCount(); ++node)
+        if (m_graph.edgesBegin(node) != m_graph.edgesEnd(node))
+            candidates.push_back(node);
+
+    if (isEmpty() || candidates.isEmpty() || queries <= 0)
+        return result;
+
+    QElapsedTimer timer;
+    uint state = seed;
+    for (int i = 0; i < queries; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const Node& from = m_graph.nodeAt(candidates[(state >> 8) % candidates.size()]);
+        state = state * 1664525u + 1013904223u;
+        const Node& to   = m_graph.nodeAt(candidates[(state >> 8) % candidates.size()]);
+
+        timer.start();
+        QVector<Node> expected = m_graph.shortestPath(from, to);
+        result.dijkstraNsecs += timer.nsecsElapsed();
+
+        timer.start();
+        QVector<Node> found = shortestPath(from, to);
+        result.hierarchyNsecs += timer.nsecsElapsed();
+
+        ++result.queries;
+        if (costOf(expected) != m_pathCost || costOf(found) != m_pathCost)
+        {
+            ++result.mismatches;
+            qDebug() << QString("Contraction hierarchy. Path from %1 to %2 costs %3, Dijkstra search found %4.")
+                        .arg(from.toString()).arg(to.toString()).arg(costOf(found)).arg(costOf(expected));
+        }
+    }
+
+    qDebug() << QString("Contraction hierarchy. %1 queries, %2 mismatches. Dijkstra: %3 us per query, hierarchy: %4 us per query.")
+                .arg(result.queries).arg(result.mismatches)
+                .arg(result.dijkstraNsecs / 1000.0 / result.queries)
+                .arg(result.hierarchyNsecs / 1000.0 / result.queries);
+
+    return result;
+}
+
+int ContractionHierarchy::contract(int node, bool simulate)
+{
+    // For every pair of neighbours {u -> node -> x} the witness search from {u} looks for another path to {x}.
+    // If there is none, that is as light as the path through the {node}, the shortcut {u -> x} is needed.
+    // Priority is the edge difference (added shortcuts minus removed arcs) plus the count of contracted neighbours,
+    // so that contraction is spread evenly over the graph.
+
+    const QVector<int>& incoming = m_incoming[node];
+    const QVector<int>& outgoing = m_outgoing[node];
+
+    int heaviest = 0;
+    foreach (int arc, outgoing)
+        heaviest = qMax(heaviest, m_arcs[arc].weight);
+
+    int shortcuts = 0;
+    if (!outgoing.isEmpty())
+    {
+        foreach (int in, incoming)
+        {
+            int from = m_arcs[in].from;
+            witnessSearch(from, node, m_arcs[in].weight + heaviest);
+
+            foreach (int out, outgoing)
+            {
+                int to = m_arcs[out].to;
+                if (to == from)
+                    continue;
+
+                int cost    = m_arcs[in].weight + m_arcs[out].weight;
+                int witness = witnessCost(to);
+                if (witness != -1 && witness <= cost)
+                    continue;
+
+                ++shortcuts;
+                if (!simulate)
+                    addArc(from, to, cost, in, out);
+            }
+        }
+    }
+
+    int priority = shortcuts - incoming.size() - outgoing.size() + m_contractedNeighbours[node];
+    if (simulate)
+        return priority;
+
+    // Contracted node leaves the graph: its neighbours forget the arcs to it.
+    foreach (int in, incoming)
+    {
+        removeArcsTo(m_outgoing[m_arcs[in].from], node, false);
+        ++m_contractedNeighbours[m_arcs[in].from];
+    }
+
+    foreach (int out, outgoing)
+    {
+        removeArcsTo(m_incoming[m_arcs[out].to], node, true);
+        ++m_contractedNeighbours[m_arcs[out].to];
+    }
+
+    m_incoming[node].clear();
+    m_outgoing[node].clear();
+
+    return priority;
+}
+
+// Adds the arc or makes the existing one lighter. Arcs between uncontracted nodes are never parts of shortcuts,
+// so they may be changed in place.
+void ContractionHierarchy::addArc(int from, int to, int weight, int first, int second)
+{
+    foreach (int index, m_outgoing[from])
+    {
+        Arc& arc = m_arcs[index];
+        if (arc.to != to)
+            continue;
+
+        if (weight < arc.weight)
+        {
+            arc.weight = weight;
+            arc.first  = first;
+            arc.second = second;
+        }
+        return;
+    }
+
+    Arc arc;
+    arc.from   = from;
+    arc.to     = to;
+    arc.weight = weight;
+    arc.first  = first;
+    arc.second = second;
+
+    m_outgoing[from].push_back(m_arcs.size());
+    m_incoming[to].push_back(m_arcs.size());
+    m_arcs.push_back(arc);
+}
+
+void ContractionHierarchy::removeArcsTo(QVector<int> &arcs, int node, bool incoming)
+{
+    for (int i = arcs.size() - 1; i >= 0; --i)
+    {
+        const Arc& arc = m_arcs[arcs[i]];
+        if ((incoming ? arc.from : arc.to) == node)
+            arcs.remove(i);
+    }
+}
+
+void ContractionHierarchy::witnessSearch(int from, int skipped, int limit)
+{
+    // Search is limited by the count of picked nodes, so it may miss a witness. That only adds an extra shortcut.
+    nextStamp();
+
+    PriorityQueue& open = m_open[0];
+    open.clear();
+
+    reach(0, from, 0, -1);
+    open.push(from, 0);
+
+    int settled = 0;
+    while (!open.isEmpty() && open.topPriority() <= limit && settled < WITNESS_SETTLE_LIMIT)
+    {
+        int node = open.pop();
+        ++settled;
+
+        foreach (int index, m_outgoing[node])
+        {
+            const Arc& arc = m_arcs[index];
+            int cost = m_cost[0][node] + arc.weight;
+
+            if (arc.to == skipped || (isReached(0, arc.to) && cost >= m_cost[0][arc.to]))
+                continue;
+
+            reach(0, arc.to, cost, index);
+            open.push(arc.to, cost);
+        }
+    }
+}
+
+// Cost of the path from the start of the last witness search (-1, if it wasn't reached).
+int ContractionHierarchy::witnessCost(int node) const
+{
+    return isReached(0, node) ? m_cost[0][node] : -1;
+}
+
+void ContractionHierarchy::nextStamp()
+{
+    if (++m_currentStamp != 0)
+        return;
+
+    // Stamps wrapped around: old data must not look like the current one.
+    m_stamp[0].fill(0);
+    m_stamp[1].fill(0);
+    m_currentStamp = 1;
+}
+
+bool ContractionHierarchy::isReached(int side, int node) const
+{
+    return m_stamp[side][node] == m_currentStamp;
+}
+
+void ContractionHierarchy::reach(int side, int node, int cost, int parent)
+{
+    m_stamp[side][node]  = m_currentStamp;
+    m_cost[side][node]   = cost;
+    m_parent[side][node] = parent;
+}
+
+// Appends nodes of the arc (without its first node) to the {result}. Shortcuts are replaced with their halves, first one goes first.
+void ContractionHierarchy::unpack(int arc, QVector<Node> &result) const
+{
+    QVector<int> stack;
+    stack.push_back(arc);
+
+    while (!stack.isEmpty())
+    {
+        const Arc& current = m_arcs[stack.takeLast()];
+        if (current.first == -1)
+        {
+            result.push_back(m_graph.nodeAt(current.to));
+            continue;
+        }
+
+        stack.push_back(current.second);
+        stack.push_back(current.first);
+    }
+}
+
+// Cost of the path along the edges of the original graph (-1 for an empty path or for a path, that doesn't follow the edges).
+int ContractionHierarchy::costOf(const QVector<Node> &path) const
+{
+    if (path.isEmpty())
+        return -1;
+
+    int result = 0;
+    for (int i = 1; i < path.size(); ++i)
+    {
+        int from = m_graph.indexOf(path.at(i - 1));
+        int to   = m_graph.indexOf(path.at(i));
+
+        int weight = -1;
+        for (int edge = m_graph.edgesBegin(from); edge < m_graph.edgesEnd(from); ++edge)
+            if (m_graph.target(edge) == to && (weight == -1 || m_graph.weight(edge) < weight))
+                weight = m_graph.weight(edge);
+
+        if (weight == -1)
+            return -1;
+
+        result += weight;
+    }
+
+    return result;
+}
@@ -0,0 +1,112 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <QVector>
+
+#include "node.h"
+#include "compactgraph.h"
+#include "priorityqueue.h"
+
+// ContractionHierarchy is the preprocessed form of the graph for maps, that are loaded once and queried many times.
+// Nodes are contracted one by one, from the least important ones (that add the fewest shortcuts) to the most important ones.
+// Contracting the node removes it from the graph: when the path through it is the only shortest path between two its neighbours,
+// they get the shortcut edge, that remembers the contracted node in the middle. Every node gets its rank in order of contraction.
+//
+// Query runs Dijkstra search from both ends, but only upwards (to the nodes of higher rank): from the start over outgoing edges,
+// from the goal against incoming ones. Both searches meet at the highest node of the shortest path, and each of them picks
+// only a small part of the graph. Shortcuts of the found path are then unpacked into the original edges.
+//
+// Hierarchy is built for the exact graph: any change of the map needs the new build.
+class ContractionHierarchy
+{
+public:
+    ContractionHierarchy();
+    ~ContractionHierarchy();
+
+    void build (const CompactGraph& graph);
+    void clear ();
+
+    bool isEmpty () const;
+    int  nodeCount () const;
+    int  shortcutCount () const;
+    const CompactGraph& graph () const;
+
+    QVector<Node> shortestPath (const Node& from, const Node& to);
+
+    // Statistics of the last query.
+    int pathCost () const;
+    int settledCount () const;
+
+    // Runs {queries} random queries both on the hierarchy and with plain Dijkstra search on the original graph
+    // (the one, SPT is built with), compares the costs of found paths and measures the time, both of them take.
+    struct Benchmark
+    {
+        int    queries    = 0;
+        int    mismatches = 0;
+        qint64 dijkstraNsecs  = 0;
+        qint64 hierarchyNsecs = 0;
+    };
+    Benchmark benchmark (int queries, uint seed = 1);
+
+private:
+    // Edge of the hierarchy. Shortcut is made of two edges {first} (from -> middle) and {second} (middle -> to),
+    // original edges have none (-1).
+    struct Arc
+    {
+        int from;
+        int to;
+        int weight;
+        int first  = -1;
+        int second = -1;
+    };
+
+    // Contraction of the {node}: shortcuts, that it needs, are added (or just counted, when {simulate} is set).
+    // Returns the priority of the node: the fewer edges contraction adds, the sooner the node is contracted.
+    int  contract (int node, bool simulate);
+    void addArc   (int from, int to, int weight, int first, int second);
+    void removeArcsTo (QVector<int>& arcs, int node, bool incoming);
+
+    // Local Dijkstra search from {from}, that avoids {skipped} node and doesn't go further than {limit}.
+    // It looks for witnesses: paths between neighbours of the contracted node, that are not longer than the ones through it.
+    void witnessSearch (int from, int skipped, int limit);
+    int  witnessCost   (int node) const;
+
+    void nextStamp ();
+    bool isReached (int side, int node) const;
+    void reach     (int side, int node, int cost, int parent);
+
+    void unpack (int arc, QVector<Node>& result) const;
+    int  costOf (const QVector<Node>& path) const;
+
+    CompactGraph m_graph;
+    QVector<Arc> m_arcs;
+    QVector<int> m_rank;
+    int          m_shortcutCount = 0;
+
+    // Contraction data. Arcs between uncontracted nodes only, contracted neighbours of every node.
+    QVector<QVector<int>> m_outgoing;
+    QVector<QVector<int>> m_incoming;
+    QVector<int>          m_contractedNeighbours;
+
+    // Upward graph (compressed sparse row): arcs to higher nodes from every node ({m_up})
+    // and arcs from higher nodes into every node ({m_down}), both as arc indices.
+    QVector<int> m_upOffsets;
+    QVector<int> m_up;
+    QVector<int> m_downOffsets;
+    QVector<int> m_down;
+
+    // Scratch data of searches. Per-node data with an old stamp is treated as unreached.
+    // Index 0 is the forward search, index 1 is the backward one.
+    QVector<int>  m_cost[2];
+    QVector<int>  m_parent[2];
+    QVector<uint> m_stamp[2];
+    uint          m_currentStamp = 0;
+    PriorityQueue m_open[2];
+
+    int m_pathCost = -1;
+    int m_settledCount = 0;
+
+    static constexpr int WITNESS_SETTLE_LIMIT = 64;
+};
+
+#endif // CONTRACTIONHIERARCHY_H
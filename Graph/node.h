@@ -1,87 +1,102 @@
-#ifndef NODE_H
-#define NODE_H
-
-#include <QVector>
-#include <QHash>
-
-#include <QDebug>
-
-// Node class represents 2-dimensional graph vertex.
-// This will be used later to find shortest path on 2d tilemap later.
-class Node
-{
-public:
-    Node(int x = -1, int y = -1);
-    ~Node();    
-
-    int x() const;
-    int y() const;
-
-    void setX(int x);
-    void setY(int y);
-
-    bool isDefault();
-
-    inline void operator= (const Node &rhs)
-    {
-        setX(rhs.x());
-        setY(rhs.y());
-    }
-
-    inline QString toString() const
-    {
-        return QString("{%1,%2}").arg(x()).arg(y());
-    }
-
-protected:
-    friend QDataStream& operator<< (QDataStream&, const Node&);
-    friend QDataStream& operator>> (QDataStream&,       Node&);
-
-private:
-    const int MIN_VALUE = 0;
-    const int MAX_VALUE = 100;
-
-    int m_x;
-    int m_y;
-};
-
-inline bool operator== (const Node &lhs, const Node &rhs)
-{
-    if (lhs.x() == rhs.x() && lhs.y() == rhs.y())
-    {
-        // qDebug() << "Shortest path. These nodes are equal.";
-        return true;
-    }
-    else
-        return false;
-}
-
-inline bool operator!= (const Node &lhs, const Node &rhs)
-{
-    if (lhs.x() != rhs.x() || lhs.y() != rhs.y())
-        return true;
-    else
-        return false;
-}
-
-inline bool operator<  (const Node &lhs, const Node &rhs)
-{
-    if (lhs.y() < rhs.y())
-        return true;
-    else if (lhs.y() == rhs.y())
-    {
-        if (lhs.x() < rhs.x())
-            return true;
-        else
-            return false;
-    }
-    else
-        return false;
-}
-
-inline uint qHash(const Node& node, uint seed)
-{
-    return qHash(node.x() + node.y(),seed);
-}
-
-#endif // NODE_H
+#ifndef NODE_H
+#define NODE_H
+
+#include <QVector>
+#include <QHash>
+
+#include <QDebug>
+
+// Packed identifier of the node: x takes the lower 16 bits, y takes the higher ones.
+// Containers, that are keyed by nodes, use it instead of the node itself.
+typedef quint32 NodeId;
+
+// Node class represents 2-dimensional graph vertex.
+// This will be used later to find shortest path on 2d tilemap later.
+// Coordinates are 16-bit, so the node takes 4 bytes (the default node is {-1,-1}).
+class Node
+{
+public:
+    Node(int x = -1, int y = -1);
+    ~Node();    
+
+    int x() const;
+    int y() const;
+
+    void setX(int x);
+    void setY(int y);
+
+    bool isDefault() const;
+
+    NodeId id() const;
+    static Node fromId(NodeId id);
+
+    inline QString toString() const
+    {
+        return QString("{%1,%2}").arg(x()).arg(y());
+    }
+
+protected:
+    friend QDataStream& operator<< (QDataStream&, const Node&);
+    friend QDataStream& operator>> (QDataStream&,       Node&);
+
+private:
+    static constexpr int MIN_VALUE = 0;
+    static constexpr int MAX_VALUE = 32767;
+
+    qint16 m_x = -1;
+    qint16 m_y = -1;
+};
+
+inline bool operator== (const Node &lhs, const Node &rhs)
+{
+    if (lhs.x() == rhs.x() && lhs.y() == rhs.y())
+    {
+        // qDebug() << "Shortest path. These nodes are equal.";
+        return true;
+    }
+    else
+        return false;
+}
+
+inline bool operator!= (const Node &lhs, const Node &rhs)
+{
+    if (lhs.x() != rhs.x() || lhs.y() != rhs.y())
+        return true;
+    else
+        return false;
+}
+
+inline bool operator<  (const Node &lhs, const Node &rhs)
+{
+    if (lhs.y() < rhs.y())
+        return true;
+    else if (lhs.y() == rhs.y())
+    {
+        if (lhs.x() < rhs.x())
+            return true;
+        else
+            return false;
+    }
+    else
+        return false;
+}
+
+// Spreads the bits of the value over the whole hash (finalizer of MurmurHash3),
+// so that the neighbouring nodes don't get the neighbouring hashes.
+inline uint mixHash(uint value)
+{
+    value ^= value >> 16;
+    value *= 0x85ebca6bU;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35U;
+    value ^= value >> 16;
+
+    return value;
+}
+
+inline uint qHash(const Node& node, uint seed)
+{
+    return mixHash(node.id() ^ seed);
+}
+
+#endif // NODE_H
@@ -0,0 +1,177 @@
+#include "priorityqueue.h"
+
+PriorityQueue::PriorityQueue(int capacity)
+{
+    reset(capacity);
+}
+
+PriorityQueue::~PriorityQueue()
+{
+
+}
+
+void PriorityQueue::reset(int capacity)
+{
+    m_heap.clear();
+    m_priority.clear();
+    m_positionOf.clear();
+    m_slots.reset(capacity);
+}
+
+// Forgets all the queued indices. Costs O(size), not O(capacity), so the queue is cheap to reuse.
+void PriorityQueue::clear()
+{
+    foreach (int slot, m_heap)
+        m_positionOf[slot] = -1;
+
+    m_heap.clear();
+    m_priority.clear();
+}
+
+int PriorityQueue::size() const
+{
+    return m_heap.size();
+}
+
+int PriorityQueue::capacity() const
+{
+    return m_slots.capacity();
+}
+
+bool PriorityQueue::isEmpty() const
+{
+    return m_heap.isEmpty();
+}
+
+bool PriorityQueue::contains(int index) const
+{
+    int slot = m_slots.slotOf(index);
+    return slot != -1 && m_positionOf[slot] != -1;
+}
+
+qint64 PriorityQueue::priorityOf(int index) const
+{
+    return m_priority[m_positionOf[m_slots.slotOf(index)]];
+}
+
+int PriorityQueue::top() const
+{
+    return m_slots.indexOf(m_heap.first());
+}
+
+qint64 PriorityQueue::topPriority() const
+{
+    return m_priority.first();
+}
+
+void PriorityQueue::push(int index, qint64 priority)
+{
+    // New block of indices gets its positions, none of them is queued yet.
+    int slot = m_slots.allocate(index);
+    if (slot >= m_positionOf.size())
+        m_positionOf += QVector<int>(BlockMap::BLOCK_SIZE, -1);
+
+    int position = m_positionOf[slot];
+
+    // New index goes to the bottom of the heap and floats up.
+    if (position == -1)
+    {
+        m_heap.push_back(slot);
+        m_priority.push_back(priority);
+        m_positionOf[slot] = m_heap.size() - 1;
+
+        siftUp(m_heap.size() - 1);
+        return;
+    }
+
+    // Queued index changes its priority and moves in the relevant direction.
+    qint64 old_priority = m_priority[position];
+    m_priority[position] = priority;
+
+    if (priority < old_priority)
+        siftUp(position);
+    else
+        siftDown(position);
+}
+
+int PriorityQueue::pop()
+{
+    int result = top();
+    remove(result);
+
+    return result;
+}
+
+void PriorityQueue::remove(int index)
+{
+    int slot = m_slots.slotOf(index);
+    if (slot == -1 || m_positionOf[slot] == -1)
+        return;
+
+    // Move the last element to the freed position and restore the heap order from there.
+    int    position      = m_positionOf[slot];
+    int    last_slot     = m_heap.last();
+    qint64 last_priority = m_priority.last();
+
+    m_heap.pop_back();
+    m_priority.pop_back();
+    m_positionOf[slot] = -1;
+
+    if (last_slot == slot)
+        return;
+
+    place(position, last_slot, last_priority);
+    siftUp(position);
+    siftDown(m_positionOf[last_slot]);
+}
+
+void PriorityQueue::siftUp(int position)
+{
+    int    slot     = m_heap[position];
+    qint64 priority = m_priority[position];
+
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (m_priority[parent] <= priority)
+            break;
+
+        place(position, m_heap[parent], m_priority[parent]);
+        position = parent;
+    }
+
+    place(position, slot, priority);
+}
+
+void PriorityQueue::siftDown(int position)
+{
+    int    slot     = m_heap[position];
+    qint64 priority = m_priority[position];
+    int    count    = m_heap.size();
+
+    while (true)
+    {
+        int child = 2 * position + 1;
+        if (child >= count)
+            break;
+
+        // Pick the lighter one of two children.
+        if (child + 1 < count && m_priority[child + 1] < m_priority[child])
+            ++child;
+
+        if (priority <= m_priority[child])
+            break;
+
+        place(position, m_heap[child], m_priority[child]);
+        position = child;
+    }
+
+    place(position, slot, priority);
+}
+
+void PriorityQueue::place(int position, int slot, qint64 priority)
+{
+    m_heap[position]     = slot;
+    m_priority[position] = priority;
+    m_positionOf[slot]   = position;
+}
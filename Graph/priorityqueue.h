@@ -0,0 +1,51 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <QVector>
+
+#include "blockmap.h"
+
+// PriorityQueue is an indexed binary min-heap, that is used by the SPT algorithm to pick the lightest node.
+// Nodes are known to the queue by their index (0 .. capacity-1), so every index remembers its position in the heap.
+// That gives us O(log n) push, pop and decrease-key instead of scanning all the unpicked nodes each time.
+// Priority is 64-bit, so the caller may pack some tie-breaking data into its lower bits, if needed.
+// Positions of the indices are kept by blocks (see BlockMap), so the queue for the big range takes memory only for
+// the indices, that were pushed.
+class PriorityQueue
+{
+public:
+    PriorityQueue(int capacity = 0);
+    ~PriorityQueue();
+
+    // Prepares the queue for indices in range [0, capacity). Clears the queue.
+    void reset (int capacity);
+    void clear ();
+
+    int  size     () const;
+    int  capacity () const;
+    bool isEmpty  () const;
+    bool contains (int index) const;
+
+    qint64 priorityOf  (int index) const;
+    int    top         () const;
+    qint64 topPriority () const;
+
+    // Inserts {index} with given {priority} or changes the priority of already queued {index}.
+    void push   (int index, qint64 priority);
+    int  pop    ();
+    void remove (int index);
+
+private:
+    void siftUp   (int slot);
+    void siftDown (int slot);
+    void place    (int position, int slot, qint64 priority);
+
+    // Heap positions hold the slots of indices and their priorities side by side,
+    // {m_positionOf} maps every slot to its position in heap (-1, if it isn't queued).
+    QVector<int>    m_heap;
+    QVector<qint64> m_priority;
+    QVector<int>    m_positionOf;
+    BlockMap        m_slots;
+};
+
+#endif // PRIORITYQUEUE_H
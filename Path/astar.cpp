@@ -0,0 +1,133 @@
+#include "astar.h"
+#include "grid.h"
+
+#include <QDebug>
+
+// Heap orders cells by {cost + estimate} and resolves equal ones in favour of the cell, that is further from the start.
+static inline qint64 priorityFor(const PriorityQueue&, int cost, int estimate)
+{
+    return (qint64(cost + estimate) << 32) - cost;
+}
+
+// Buckets give the last pushed cell first among equal ones, and that is usually the one, that is further from the start.
+static inline qint64 priorityFor(const BucketQueue&, int cost, int estimate)
+{
+    return cost + estimate;
+}
+
+AStar::AStar()
+{
+
+}
+
+AStar::~AStar()
+{
+
+}
+
+QVector<Node> AStar::shortestPath(const Grid &grid, const Node &from, const Node &to, const Heuristic &heuristic)
+{
+    m_space.prepare(grid.width() * grid.height());
+    m_pathCost = -1;
+    m_expandedCount = 0;
+
+    if (!grid.contains(from) || !grid.contains(to) || grid.isFilled(from) || grid.isFilled(to))
+    {
+        qDebug() << "Shortest path. A*: start or goal node can't be traced.";
+        return QVector<Node>();
+    }
+
+    int start  = grid.indexOf(from);
+    int target = grid.indexOf(to);
+
+    if (canUseBuckets(grid, heuristic))
+    {
+        // Single step changes {cost + estimate} by the cost of the step plus the change of estimate.
+        m_space.buckets().setMaxStep(grid.maximumStepCost() + heuristic.maximumStepChange(grid.maximumStepCost()));
+        return search(grid, start, target, heuristic, m_space.buckets());
+    }
+
+    return search(grid, start, target, heuristic, m_space.open());
+}
+
+template <typename Queue>
+QVector<Node> AStar::search(const Grid &grid, int start, int target, const Heuristic &heuristic, Queue &open)
+{
+    // 1. Mark all the cells as unreached and put the starting cell into the open queue.
+    // 2. While there are open cells:
+    //    - Take the one with the lowest {cost + estimate}. If it is the goal, we are done.
+    //    - Update costs of its unfilled neighbours and (re)open those, that became cheaper.
+    // 3. Walk back from the goal using remembered parents to get the path.
+
+    Node goal = grid.nodeAt(target);
+
+    m_space.reach(start, 0, -1);
+    open.push(start, priorityFor(open, 0, heuristic.estimate(grid.nodeAt(start), goal)));
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        ++m_expandedCount;
+
+        if (current == target)
+        {
+            m_pathCost = m_space.cost(target);
+            qDebug() << QString("Shortest path. A*: goal reached. Cost: %1. Expanded nodes: %2.").arg(m_pathCost).arg(m_expandedCount);
+
+            return m_space.tracePath(grid, target);
+        }
+
+        int cost  = m_space.cost(current);
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next     = neighbours[i];
+            int new_cost = cost + grid.stepCost(current, next);
+            int old_cost = m_space.cost(next);
+
+            // Unreached cell has cost -1.
+            if (old_cost != -1 && new_cost >= old_cost)
+                continue;
+
+            m_space.reach(next, new_cost, current);
+            open.push(next, priorityFor(open, new_cost, heuristic.estimate(grid.nodeAt(next), goal)));
+        }
+    }
+
+    qDebug() << QString("Shortest path. A*: goal can't be reached. Expanded nodes: %1.").arg(m_expandedCount);
+    return QVector<Node>();
+}
+
+bool AStar::bucketQueue() const
+{
+    return m_bucketQueue;
+}
+
+void AStar::setBucketQueue(bool allowed)
+{
+    m_bucketQueue = allowed;
+}
+
+// Buckets need {cost + estimate} never to decrease along the search. That is true for all the heuristics,
+// except MANHATTAN one on the grid with diagonal movement (it overestimates diagonal steps).
+bool AStar::canUseBuckets(const Grid &grid, const Heuristic &heuristic) const
+{
+    if (!m_bucketQueue)
+        return false;
+
+    if (heuristic.type() == Heuristic::Type::MANHATTAN && grid.diagonalMovement())
+        return false;
+
+    return grid.maximumStepCost() + heuristic.maximumStepChange(grid.maximumStepCost()) <= BucketQueue::MAX_STEP;
+}
+
+int AStar::pathCost() const
+{
+    return m_pathCost;
+}
+
+int AStar::expandedCount() const
+{
+    return m_expandedCount;
+}
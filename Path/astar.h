@@ -0,0 +1,49 @@
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+#include "heuristic.h"
+#include "searchspace.h"
+
+class Grid;
+
+// AStar is goal-directed search of the shortest path between two cells of the grid.
+// Unlike SPT algorithm, it doesn't need the graph to be built: neighbours of the cell and step costs are taken from the grid itself.
+// Cells are opened in order of {cost from start + estimated cost to goal}, so the search moves towards the goal
+// and stops as soon as the goal is reached, leaving most of the map untouched.
+// With ZERO heuristic it is plain Dijkstra search on the grid. Search data is kept between the queries and reused.
+//
+// Open cells are kept either in binary heap or in buckets (see BucketQueue). Buckets are used, when they are allowed and
+// the steps of the grid are cheap, but only if {cost + estimate} never decreases along the search (heuristic is consistent).
+class AStar
+{
+public:
+    AStar();
+    ~AStar();
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to, const Heuristic& heuristic);
+
+    bool bucketQueue () const;
+    void setBucketQueue (bool allowed);
+
+    // Statistics of the last search.
+    int pathCost () const;
+    int expandedCount () const;
+
+private:
+    bool canUseBuckets (const Grid& grid, const Heuristic& heuristic) const;
+
+    template <typename Queue>
+    QVector<Node> search (const Grid& grid, int start, int target, const Heuristic& heuristic, Queue& open);
+
+    // Per-cell data of the search (indexed by the cell index of the grid).
+    SearchSpace m_space;
+    bool        m_bucketQueue = true;
+
+    int m_pathCost = -1;
+    int m_expandedCount = 0;
+};
+
+#endif // ASTAR_H
@@ -0,0 +1,87 @@
+#include "batchsearch.h"
+#include "grid.h"
+
+#include <QRunnable>
+#include <QThread>
+#include <QAtomicInt>
+#include <QDebug>
+
+// Worker of the batch. Workers of one batch share the counter of taken queries, so the threads, that got the short paths,
+// just take more of them, and all the threads end at about the same time.
+class BatchWorker : public QRunnable
+{
+public:
+    BatchWorker(const Grid& grid, const QVector<QPair<Node, Node>>& queries, const QVector<bool>& skipped,
+                const Heuristic& heuristic, AStar& search, QAtomicInt& next, QVector<Node>* results)
+        : m_grid(grid), m_queries(queries), m_skipped(skipped),
+          m_heuristic(heuristic), m_search(search), m_next(next), m_results(results)
+    {
+
+    }
+
+    void run() override
+    {
+        for (int query = m_next.fetchAndAddRelaxed(1); query < m_queries.size(); query = m_next.fetchAndAddRelaxed(1))
+            if (!m_skipped.at(query))
+                m_results[query] = m_search.shortestPath(m_grid, m_queries.at(query).first, m_queries.at(query).second, m_heuristic);
+    }
+
+private:
+    const Grid&                       m_grid;
+    const QVector<QPair<Node, Node>>& m_queries;
+    const QVector<bool>&              m_skipped;
+    const Heuristic&                  m_heuristic;
+    AStar&                            m_search;
+    QAtomicInt&                       m_next;
+    QVector<Node>*                    m_results;
+};
+
+BatchSearch::BatchSearch()
+{
+    setThreadCount(QThread::idealThreadCount());
+}
+
+BatchSearch::~BatchSearch()
+{
+    m_pool.waitForDone();
+}
+
+int BatchSearch::threadCount() const
+{
+    return m_searches.size();
+}
+
+void BatchSearch::setThreadCount(int count)
+{
+    if (count < 1)
+        count = 1;
+
+    m_pool.waitForDone();
+    m_pool.setMaxThreadCount(count);
+    m_searches.resize(count);
+}
+
+QVector<QVector<Node>> BatchSearch::shortestPaths(const Grid &grid, const QVector<QPair<Node, Node>> &queries,
+                                                  const QVector<bool> &skipped, const Heuristic &heuristic)
+{
+    // Result slots are allocated before the threads start, so that every worker writes only to the slots of its queries.
+    QVector<QVector<Node>> result (queries.size());
+    if (queries.isEmpty())
+        return result;
+
+    QAtomicInt next (0);
+    int workers = qMin(threadCount(), queries.size());
+
+    // Chunks of the grid, that the threads read, must not be evicted under them.
+    grid.pinChunks();
+
+    for (int i = 0; i < workers; ++i)
+        m_pool.start(new BatchWorker(grid, queries, skipped, heuristic, m_searches[i], next, result.data()));
+
+    m_pool.waitForDone();
+    grid.unpinChunks();
+
+    qDebug() << QString("Shortest path. Batch of %1 queries was answered by %2 threads.").arg(queries.size()).arg(workers);
+
+    return result;
+}
@@ -0,0 +1,36 @@
+#ifndef BATCHSEARCH_H
+#define BATCHSEARCH_H
+
+#include <QVector>
+#include <QPair>
+#include <QThreadPool>
+
+#include "Graph/node.h"
+#include "astar.h"
+#include "heuristic.h"
+
+class Grid;
+
+// BatchSearch answers many path queries at once (f.e. paths of all the creatures, that make their turn in the same tick).
+// Queries are spread over the threads of its own pool: every thread takes the next unanswered query, until there are none,
+// and searches it with its own A* (search data is never shared). The grid is only read by the searches,
+// so it must not change, until the batch is done. Paths are returned in order of the queries.
+class BatchSearch
+{
+public:
+    BatchSearch();
+    ~BatchSearch();
+
+    int  threadCount () const;
+    void setThreadCount (int count);
+
+    // {queries} are pairs of {from, to}. Query, that is marked as unreachable in {skipped}, gets an empty path without search.
+    QVector<QVector<Node>> shortestPaths (const Grid& grid, const QVector<QPair<Node, Node>>& queries,
+                                          const QVector<bool>& skipped, const Heuristic& heuristic);
+
+private:
+    QThreadPool    m_pool;
+    QVector<AStar> m_searches;
+};
+
+#endif // BATCHSEARCH_H
@@ -0,0 +1,152 @@
+#include "bidirectionalsearch.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+// Open cells are ordered by their keys, and equal ones by the cost (further from the origin goes first).
+static inline qint64 priorityFor(qint64 key, int cost)
+{
+    return (key << 32) - cost;
+}
+
+// Returns the key part of the priority.
+static inline qint64 keyOf(qint64 priority)
+{
+    return (priority + 0xFFFFFFFFLL) >> 32;
+}
+
+BidirectionalSearch::BidirectionalSearch()
+{
+
+}
+
+BidirectionalSearch::~BidirectionalSearch()
+{
+
+}
+
+QVector<Node> BidirectionalSearch::shortestPath(const Grid &grid, const Node &from, const Node &to, const Heuristic &heuristic)
+{
+    m_forward.prepare(grid.width() * grid.height());
+    m_backward.prepare(grid.width() * grid.height());
+    m_bestCost = -1;
+    m_meeting  = -1;
+    m_pathCost = -1;
+    m_expandedCount = 0;
+
+    if (!grid.contains(from) || !grid.contains(to) || grid.isFilled(from) || grid.isFilled(to))
+    {
+        qDebug() << "Shortest path. Bidirectional: start or goal node can't be traced.";
+        return QVector<Node>();
+    }
+
+    int start = grid.indexOf(from);
+    int goal  = grid.indexOf(to);
+
+    m_from = from;
+    m_to   = to;
+
+    m_forward.reach(start, 0, -1);
+    m_forward.open().push(start, priorityFor(keyFor(start, 0, grid, heuristic, false), 0));
+
+    m_backward.reach(goal, 0, -1);
+    m_backward.open().push(goal, priorityFor(keyFor(goal, 0, grid, heuristic, true), 0));
+
+    if (start == goal)
+    {
+        m_bestCost = 0;
+        m_meeting  = start;
+    }
+
+    // Every step expands the frontier with the lower key, so both of them grow evenly.
+    while (!m_forward.open().isEmpty() && !m_backward.open().isEmpty())
+    {
+        qint64 forwardKey  = keyOf(m_forward.open().topPriority());
+        qint64 backwardKey = keyOf(m_backward.open().topPriority());
+
+        // Stopping criterion. Any path, that is not found yet, goes through the open cells of both frontiers,
+        // and its cost is not lower than the half of the sum of their keys.
+        if (m_bestCost != -1 && forwardKey + backwardKey >= 2 * qint64(m_bestCost))
+            break;
+
+        if (forwardKey <= backwardKey)
+            expand(grid, m_forward, m_backward, heuristic, false);
+        else
+            expand(grid, m_backward, m_forward, heuristic, true);
+    }
+
+    if (m_bestCost == -1)
+    {
+        qDebug() << QString("Shortest path. Bidirectional: goal can't be reached. Expanded nodes: %1.").arg(m_expandedCount);
+        return QVector<Node>();
+    }
+
+    m_pathCost = m_bestCost;
+    qDebug() << QString("Shortest path. Bidirectional: goal reached. Cost: %1. Expanded nodes: %2.").arg(m_pathCost).arg(m_expandedCount);
+
+    return tracePath(grid);
+}
+
+int BidirectionalSearch::pathCost() const
+{
+    return m_pathCost;
+}
+
+int BidirectionalSearch::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+// Both directions use the average of two estimates: {(to goal - from start) / 2} for the forward search and the opposite one for the backward search.
+// They sum up to zero, so the keys of both frontiers are measured in the same units, and the stopping criterion holds for A* too.
+// Keys are doubled to stay integer: {2 * cost + estimate to goal - estimate from start}.
+qint64 BidirectionalSearch::keyFor(int cell, int cost, const Grid &grid, const Heuristic &heuristic, bool backward) const
+{
+    Node node = grid.nodeAt(cell);
+    int toGoal    = heuristic.estimate(node, m_to);
+    int fromStart = heuristic.estimate(m_from, node);
+
+    return 2 * qint64(cost) + (backward ? fromStart - toGoal : toGoal - fromStart);
+}
+
+void BidirectionalSearch::expand(const Grid &grid, SearchSpace &space, const SearchSpace &other, const Heuristic &heuristic, bool backward)
+{
+    int current = space.open().pop();
+    ++m_expandedCount;
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    int count = grid.unfilledNeighboursOf(current, neighbours);
+    for (int i = 0; i < count; ++i)
+    {
+        // Movement rules are symmetric, so the neighbours, the backward search comes from, are the same cells.
+        int next     = neighbours[i];
+        int step     = backward ? grid.stepCost(next, current) : grid.stepCost(current, next);
+        int new_cost = space.cost(current) + step;
+
+        if (space.isReached(next) && new_cost >= space.cost(next))
+            continue;
+
+        space.reach(next, new_cost, current);
+        space.open().push(next, priorityFor(keyFor(next, new_cost, grid, heuristic, backward), new_cost));
+
+        // Both frontiers have reached this cell: there is the path through it.
+        if (other.isReached(next) && (m_bestCost == -1 || new_cost + other.cost(next) < m_bestCost))
+        {
+            m_bestCost = new_cost + other.cost(next);
+            m_meeting  = next;
+        }
+    }
+}
+
+// Forward parents lead from the meeting cell to the start, backward ones lead from it to the goal.
+QVector<Node> BidirectionalSearch::tracePath(const Grid &grid) const
+{
+    QVector<Node> result = m_forward.tracePath(grid, m_meeting);
+
+    for (int cell = m_backward.parent(m_meeting); cell != -1; cell = m_backward.parent(cell))
+        result.push_back(grid.nodeAt(cell));
+
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef BIDIRECTIONALSEARCH_H
+#define BIDIRECTIONALSEARCH_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+#include "heuristic.h"
+#include "searchspace.h"
+
+class Grid;
+
+// BidirectionalSearch grows two search frontiers at once: the forward one from the start and the backward one from the goal.
+// They meet approximately in the middle, so each of them covers the circle of half the radius of the one-sided search.
+//
+// Steps on the grid are not symmetric: the step costs the weight of the cell, it leads to. So the backward search moves
+// against the edges: going back from the cell {v} to its neighbour {u} costs the step {u -> v}, that is the weight of {v}.
+// The search remembers the best path through the cells, that both frontiers have reached, and stops,
+// when the lowest keys of the frontiers prove, that no path through the open cells can be cheaper.
+// With ZERO heuristic it is bidirectional Dijkstra search, otherwise both directions are A* with average estimates.
+class BidirectionalSearch
+{
+public:
+    BidirectionalSearch();
+    ~BidirectionalSearch();
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to, const Heuristic& heuristic);
+
+    // Statistics of the last search.
+    int pathCost () const;
+    int expandedCount () const;
+
+private:
+    // Takes one cell out of the {open} queue of the {space} and relaxes its neighbours.
+    void   expand (const Grid& grid, SearchSpace& space, const SearchSpace& other, const Heuristic& heuristic, bool backward);
+    qint64 keyFor (int cell, int cost, const Grid& grid, const Heuristic& heuristic, bool backward) const;
+
+    QVector<Node> tracePath (const Grid& grid) const;
+
+    SearchSpace m_forward;
+    SearchSpace m_backward;
+    Node        m_from;
+    Node        m_to;
+
+    // The best path found so far goes through the {m_meeting} cell.
+    int m_bestCost = -1;
+    int m_meeting  = -1;
+
+    int m_pathCost = -1;
+    int m_expandedCount = 0;
+};
+
+#endif // BIDIRECTIONALSEARCH_H
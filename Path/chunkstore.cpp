@@ -0,0 +1,391 @@
+#include "chunkstore.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <cstring>
+
+// Bytes of the filled flags of one chunk and the size of its record in the page file (weights, then filled flags).
+static const int FLAGS_BYTES  = ChunkStore::CHUNK_SIZE * ChunkStore::CHUNK_SIZE / 8;
+static const int RECORD_BYTES = ChunkStore::CHUNK_SIZE * ChunkStore::CHUNK_SIZE + FLAGS_BYTES;
+
+ChunkStore::ChunkStore()
+{
+
+}
+
+ChunkStore::ChunkStore(const ChunkStore &other)
+{
+    copyFrom(other);
+}
+
+// The store keeps its own page file: cells of the {other} are copied to memory.
+ChunkStore &ChunkStore::operator=(const ChunkStore &other)
+{
+    if (this != &other)
+    {
+        clear();
+        copyFrom(other);
+    }
+
+    return *this;
+}
+
+ChunkStore::~ChunkStore()
+{
+    clear();
+
+    if (m_file)
+    {
+        m_file->remove();
+        delete m_file;
+    }
+}
+
+void ChunkStore::reset(int width, int height)
+{
+    clear();
+
+    m_width  = width;
+    m_height = height;
+    m_chunksInRow = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    int count = m_chunksInRow * ((height + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    m_chunks = QVector<QAtomicPointer<Chunk>>(count);
+    m_onDisk = QBitArray(count, false);
+}
+
+// Cells are moved to the chunks of the new size one by one. It happens only when the map is loaded, so it isn't optimized.
+void ChunkStore::resize(int width, int height)
+{
+    if (width == m_width && height == m_height)
+        return;
+
+    ChunkStore resized;
+    resized.reset(width, height);
+
+    for (int y = 0; y < qMin(height, m_height); ++y)
+    {
+        for (int x = 0; x < qMin(width, m_width); ++x)
+        {
+            int from = y * m_width + x;
+            int to   = y * width + x;
+
+            if (isFilled(from))
+                resized.setFilled(to, true);
+
+            if (weightOf(from) != 0)
+                resized.setWeight(to, weightOf(from));
+        }
+    }
+
+    reset(width, height);
+
+    // Chunks are taken from the resized store, so that they are not copied once more.
+    m_chunks = resized.m_chunks;
+    m_residentCount = resized.m_residentCount;
+    resized.m_chunks = QVector<QAtomicPointer<Chunk>>();
+    resized.m_residentCount = 0;
+
+    QMutexLocker locker (&m_mutex);
+    evictOverBudget(-1);
+}
+
+void ChunkStore::unfillAll()
+{
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+        if (m_chunks.at(chunk).loadRelaxed() || m_onDisk.testBit(chunk))
+            memset(writableChunkAt(chunk)->filled, 0, FLAGS_BYTES);
+}
+
+// Square, that lies inside one chunk, is read from it right away: three rows of three flags.
+// Square on the border of the chunk takes its cells one by one.
+int ChunkStore::filledAround(int x, int y) const
+{
+    int column = x % CHUNK_SIZE;
+    int row    = y % CHUNK_SIZE;
+    int result = 0;
+
+    if (column > 0 && column < CHUNK_SIZE - 1 && row > 0 && row < CHUNK_SIZE - 1)
+    {
+        int offset;
+        const Chunk* data = chunkAt(locate(x, y, &offset));
+        if (!data)
+            return 0;
+
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            // Three flags cross into the next byte only from the last two bits of the first one.
+            int first = offset + dy * CHUNK_SIZE - 1;
+            int flags = data->filled[first >> 3];
+            if ((first & 7) > 5)
+                flags |= data->filled[(first >> 3) + 1] << 8;
+            result |= ((flags >> (first & 7)) & 7) << ((dy + 1) * 3);
+        }
+
+        return result;
+    }
+
+    for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx)
+            if (x + dx >= 0 && x + dx < m_width && y + dy >= 0 && y + dy < m_height && isFilled(x + dx, y + dy))
+                result |= 1 << ((dy + 1) * 3 + dx + 1);
+
+    return result;
+}
+
+// Default cells of the chunk, that was never written, are not written: the chunk is allocated only for the other values.
+void ChunkStore::setFilled(int cell, bool filled)
+{
+    int offset;
+    int chunk = locate(cell % m_width, cell / m_width, &offset);
+
+    if (!filled && !m_chunks.at(chunk).loadRelaxed() && !m_onDisk.testBit(chunk))
+        return;
+
+    Chunk* data = writableChunkAt(chunk);
+    if (filled)
+        data->filled[offset >> 3] |= quint8(1 << (offset & 7));
+    else
+        data->filled[offset >> 3] &= quint8(~(1 << (offset & 7)));
+}
+
+void ChunkStore::setWeight(int cell, int weight)
+{
+    int offset;
+    int chunk = locate(cell % m_width, cell / m_width, &offset);
+
+    if (weight == 0 && !m_chunks.at(chunk).loadRelaxed() && !m_onDisk.testBit(chunk))
+        return;
+
+    writableChunkAt(chunk)->weights[offset] = quint8(weight);
+}
+
+// Chunks, that are only in the old page file, are read back before it is removed. The new file has no records yet,
+// so every resident chunk is dirty for it.
+bool ChunkStore::setPageFile(const QString &filename)
+{
+    int budget = m_budget;
+    m_budget = 0;
+
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+        if (!m_chunks.at(chunk).loadRelaxed() && m_onDisk.testBit(chunk))
+            pageIn(chunk);
+
+    if (m_file)
+    {
+        m_file->remove();
+        delete m_file;
+        m_file = nullptr;
+    }
+
+    m_onDisk.fill(false);
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+        if (Chunk* data = m_chunks.at(chunk).loadRelaxed())
+            data->dirty = true;
+
+    m_budget = budget;
+    if (filename.isEmpty())
+        return true;
+
+    m_file = new QFile(filename);
+    if (!m_file->open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        qDebug() << QString("Chunk store. Could not open page file %1.").arg(filename);
+        delete m_file;
+        m_file = nullptr;
+        return false;
+    }
+
+    QMutexLocker locker (&m_mutex);
+    evictOverBudget(-1);
+    return true;
+}
+
+QString ChunkStore::pageFile() const
+{
+    return m_file ? m_file->fileName() : QString();
+}
+
+void ChunkStore::setBudget(int chunks)
+{
+    m_budget = qMax(chunks, 0);
+
+    QMutexLocker locker (&m_mutex);
+    evictOverBudget(-1);
+}
+
+int ChunkStore::budget() const
+{
+    return m_budget;
+}
+
+void ChunkStore::pin() const
+{
+    QMutexLocker locker (&m_mutex);
+    ++m_pinCount;
+}
+
+// Chunks, that were paged in while the store was pinned, are evicted now.
+void ChunkStore::unpin() const
+{
+    QMutexLocker locker (&m_mutex);
+    if (--m_pinCount == 0)
+        evictOverBudget(-1);
+}
+
+int ChunkStore::chunkCount() const
+{
+    return m_chunks.size();
+}
+
+int ChunkStore::residentCount() const
+{
+    return m_residentCount;
+}
+
+int ChunkStore::pagedInCount() const
+{
+    return m_pagedInCount.loadRelaxed();
+}
+
+// Chunk, that is not in memory, is either paged out or never written.
+const ChunkStore::Chunk *ChunkStore::missingChunkAt(int chunk) const
+{
+    return m_onDisk.testBit(chunk) ? pageIn(chunk) : nullptr;
+}
+
+ChunkStore::Chunk *ChunkStore::writableChunkAt(int chunk)
+{
+    Chunk* data = m_chunks.at(chunk).loadRelaxed();
+
+    if (!data && m_onDisk.testBit(chunk))
+        data = pageIn(chunk);
+
+    if (!data)
+    {
+        QMutexLocker locker (&m_mutex);
+
+        data = new Chunk();
+        m_chunks[chunk].storeRelease(data);
+        ++m_residentCount;
+        evictOverBudget(chunk);
+    }
+
+    data->referenced.storeRelaxed(1);
+    data->dirty = true;
+    return data;
+}
+
+// Reads the chunk from the page file. Threads, that need the same chunk, wait for the first one, so it is read only once.
+ChunkStore::Chunk *ChunkStore::pageIn(int chunk) const
+{
+    QMutexLocker locker (&m_mutex);
+
+    Chunk* data = m_chunks.at(chunk).loadAcquire();
+    if (data)
+        return data;
+
+    data = new Chunk();
+
+    qint64 position = qint64(chunk) * RECORD_BYTES;
+    if (!m_file->seek(position)
+            || m_file->read(reinterpret_cast<char*>(data->weights), CHUNK_CELLS) != CHUNK_CELLS
+            || m_file->read(reinterpret_cast<char*>(data->filled), FLAGS_BYTES) != FLAGS_BYTES)
+        qDebug() << QString("Chunk store. Chunk %1 could not be read from page file %2.").arg(chunk).arg(m_file->fileName());
+
+    data->referenced.storeRelaxed(1);
+    m_chunks[chunk].storeRelease(data);
+    ++m_residentCount;
+    m_pagedInCount.fetchAndAddRelaxed(1);
+
+    evictOverBudget(chunk);
+    return data;
+}
+
+// Clock sweep over the chunk table: referenced chunk gets its flag cleared and the second chance,
+// the chunk, that wasn't used since the hand passed it last time, is evicted. The {keep} chunk is the one, that is being used now.
+// Without the page file nothing can be evicted, so the sweep is skipped: otherwise every new chunk would pay for it.
+// Must be called with the mutex locked.
+void ChunkStore::evictOverBudget(int keep) const
+{
+    int count = m_chunks.size();
+    if (!m_file || m_budget == 0 || m_pinCount > 0 || count == 0)
+        return;
+
+    // Every chunk is passed at most twice: the first time its flag is cleared, the second time it is evicted.
+    for (int step = 0; step < 2 * count && m_residentCount > m_budget; ++step)
+    {
+        int chunk = m_clockHand;
+        m_clockHand = (m_clockHand + 1) % count;
+
+        Chunk* data = m_chunks.at(chunk).loadRelaxed();
+        if (!data || chunk == keep)
+            continue;
+
+        if (data->referenced.loadRelaxed())
+            data->referenced.storeRelaxed(0);
+        else
+            evict(chunk);
+    }
+}
+
+// Dirty chunk is written to the page file first. Without the page file it can't be evicted: its cells would be lost.
+bool ChunkStore::evict(int chunk) const
+{
+    Chunk* data = m_chunks.at(chunk).loadRelaxed();
+
+    if (data->dirty)
+    {
+        qint64 position = qint64(chunk) * RECORD_BYTES;
+        if (!m_file || !m_file->seek(position)
+                || m_file->write(reinterpret_cast<const char*>(data->weights), CHUNK_CELLS) != CHUNK_CELLS
+                || m_file->write(reinterpret_cast<const char*>(data->filled), FLAGS_BYTES) != FLAGS_BYTES)
+            return false;
+
+        m_onDisk.setBit(chunk);
+    }
+
+    m_chunks[chunk].storeRelease(nullptr);
+    --m_residentCount;
+    delete data;
+    return true;
+}
+
+void ChunkStore::clear()
+{
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+        delete m_chunks.at(chunk).loadRelaxed();
+
+    m_chunks.clear();
+    m_onDisk = QBitArray();
+    m_residentCount = 0;
+    m_pagedInCount.storeRelaxed(0);
+    m_clockHand = 0;
+}
+
+// Copy has no page file yet, so the cells of the {other} are copied to memory, even those, that are paged out there.
+void ChunkStore::copyFrom(const ChunkStore &other)
+{
+    m_budget = other.m_budget;
+    reset(other.m_width, other.m_height);
+
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+    {
+        const Chunk* source = other.chunkAt(chunk);
+        if (!source)
+            continue;
+
+        Chunk* data = new Chunk();
+        memcpy(data->weights, source->weights, CHUNK_CELLS);
+        memcpy(data->filled, source->filled, FLAGS_BYTES);
+        data->dirty = true;
+
+        m_chunks[chunk].storeRelaxed(data);
+        ++m_residentCount;
+    }
+
+    QMutexLocker locker (&m_mutex);
+    evictOverBudget(-1);
+}
@@ -0,0 +1,156 @@
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+
+#include <QVector>
+#include <QBitArray>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QMutex>
+#include <QString>
+
+class QFile;
+
+// ChunkStore keeps the cells of the grid (filled flag and weight) in square chunks of CHUNK_SIZE x CHUNK_SIZE cells,
+// so that the big world takes memory only for the parts of it, that are used.
+// - Chunk is allocated at the first write, that differs from the default cell (unfilled, weight 0).
+//   Chunks, that were never written, take nothing and read as default cells.
+// - With the page file, resident chunks are limited by the budget: the least recently used chunks are written to the file
+//   and dropped, and they are paged in again at the first read. Use is tracked by the reference flag of the chunk
+//   (clock algorithm, the approximation of LRU, that doesn't reorder anything on reads).
+// - Without the page file (or with zero budget) every chunk, that was written, stays resident.
+//
+// Reads are safe from many threads at once: paging in is serialized by the mutex. Eviction frees the chunks, that the other
+// threads may be reading, so while the chunks are pinned ({pin} / {unpin}), they are paged in, but never evicted.
+class ChunkStore
+{
+public:
+    static constexpr int CHUNK_SIZE = 64;
+
+    ChunkStore();
+    ChunkStore(const ChunkStore& other);
+    ChunkStore& operator= (const ChunkStore& other);
+    ~ChunkStore();
+
+    // Forgets all the cells: the store gets {width} x {height} default cells.
+    void reset  (int width, int height);
+    // Changes the size, keeping the cells, that stay in the store.
+    void resize (int width, int height);
+    // Clears filled flags of all the cells, keeping their weights.
+    void unfillAll ();
+
+    // Cells are indexed row by row (y * width + x), as in the grid.
+    bool isFilled    (int cell) const;
+    bool isFilled    (int x, int y) const;
+    int  weightOf    (int cell) const;
+    int  weightOf    (int x, int y) const;
+    void setFilled   (int cell, bool filled);
+    void setWeight   (int cell, int weight);
+
+    // Filled flags of the 3x3 square around the cell {x, y}: bit (dy + 1) * 3 + (dx + 1) is the cell {x + dx, y + dy}.
+    // Cells outside the store read as unfilled. Search takes all the neighbours of the cell by one call.
+    int  filledAround (int x, int y) const;
+
+    // Page file is the scratch file, that is truncated on open and removed with the store. Empty name drops it.
+    bool setPageFile (const QString& filename);
+    QString pageFile () const;
+
+    // Budget is the count of resident chunks (0 means no limit). It takes effect only with the page file.
+    void setBudget (int chunks);
+    int  budget    () const;
+
+    void pin   () const;
+    void unpin () const;
+
+    // Statistics: chunks of the whole store, chunks in memory, chunks read from the page file since the last reset.
+    int chunkCount    () const;
+    int residentCount () const;
+    int pagedInCount  () const;
+
+private:
+    static constexpr int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+    // Cells are laid out row by row inside the chunk. Filled flags take one bit, weights take one byte.
+    // {referenced} is set by every access and cleared by the clock hand, {dirty} means the page file doesn't have the latest cells.
+    struct Chunk
+    {
+        quint8     weights[CHUNK_CELLS] = {};
+        quint8     filled[CHUNK_CELLS / 8] = {};
+        QAtomicInt referenced;
+        bool       dirty = false;
+    };
+
+    int   locate        (int x, int y, int* offset) const;
+    const Chunk* chunkAt (int chunk) const;
+    const Chunk* missingChunkAt (int chunk) const;
+    Chunk* writableChunkAt (int chunk);
+    Chunk* pageIn       (int chunk) const;
+    void  evictOverBudget (int keep) const;
+    bool  evict         (int chunk) const;
+    void  clear         ();
+    void  copyFrom      (const ChunkStore& other);
+
+    int m_width       = 0;
+    int m_height      = 0;
+    int m_chunksInRow = 0;
+    int m_budget      = 0;
+
+    // Chunk table: nullptr for the chunks, that are not in memory.
+    // {m_onDisk} marks the chunks, that have their record in the page file (record of chunk N is at N * record size).
+    mutable QVector<QAtomicPointer<Chunk>> m_chunks;
+    mutable QBitArray  m_onDisk;
+    mutable int        m_residentCount = 0;
+    mutable QAtomicInt m_pagedInCount;
+    mutable int        m_clockHand = 0;
+    mutable int        m_pinCount  = 0;
+    mutable QMutex     m_mutex;
+    QFile*             m_file = nullptr;
+};
+
+// Search reads the cells at every step, so reading the resident chunk is inline. Paging in is not: it is rare and long.
+inline bool ChunkStore::isFilled(int cell) const
+{
+    return isFilled(cell % m_width, cell / m_width);
+}
+
+inline bool ChunkStore::isFilled(int x, int y) const
+{
+    int offset;
+    const Chunk* data = chunkAt(locate(x, y, &offset));
+
+    return data && ((data->filled[offset >> 3] >> (offset & 7)) & 1);
+}
+
+inline int ChunkStore::weightOf(int cell) const
+{
+    return weightOf(cell % m_width, cell / m_width);
+}
+
+inline int ChunkStore::weightOf(int x, int y) const
+{
+    int offset;
+    const Chunk* data = chunkAt(locate(x, y, &offset));
+
+    return data ? data->weights[offset] : 0;
+}
+
+// Returns the chunk of the cell and writes the index of the cell inside the chunk to {offset}.
+inline int ChunkStore::locate(int x, int y, int *offset) const
+{
+    *offset = (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+    return (y / CHUNK_SIZE) * m_chunksInRow + x / CHUNK_SIZE;
+}
+
+// Returns nullptr for the chunk, that was never written: all its cells are default.
+inline const ChunkStore::Chunk *ChunkStore::chunkAt(int chunk) const
+{
+    Chunk* data = m_chunks.at(chunk).loadAcquire();
+    if (!data)
+        return missingChunkAt(chunk);
+
+    if (!data->referenced.loadRelaxed())
+        data->referenced.storeRelaxed(1);
+
+    return data;
+}
+
+#endif // CHUNKSTORE_H
@@ -0,0 +1,306 @@
+#include "connectedcomponents.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+// Constants are bound to references (qMin, fill), so they need the definitions.
+constexpr int     ConnectedComponents::CHUNK_SIZE;
+constexpr int     ConnectedComponents::CHUNK_CELLS;
+constexpr quint16 ConnectedComponents::NONE;
+
+ConnectedComponents::ConnectedComponents()
+{
+
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+
+}
+
+// Every chunk gets the labels of the empty chunk: they are shared, until the chunk is changed.
+void ConnectedComponents::reset(int width, int height)
+{
+    m_width       = width;
+    m_height      = height;
+    m_chunksInRow = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    int chunksInColumn = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    Chunk empty;
+    empty.seeds.fill(0, 1);
+    empty.border.fill(0, 4 * CHUNK_SIZE);
+
+    m_chunks.fill(empty, m_chunksInRow * chunksInColumn);
+    m_firstNode.clear();
+    m_parent.clear();
+    m_rank.clear();
+    m_count    = 0;
+    m_outdated = true;
+}
+
+void ConnectedComponents::change(int cell)
+{
+    m_chunks[chunkOf(cell)].changed = true;
+    m_outdated = true;
+}
+
+int ConnectedComponents::labelOf(const ChunkStore &cells, int cell) const
+{
+    if (cell < 0 || cell >= m_width * m_height || cells.isFilled(cell))
+        return -1;
+
+    update(cells);
+
+    return find(m_firstNode[chunkOf(cell)] + localIndexOf(cells, cell));
+}
+
+int ConnectedComponents::componentCount(const ChunkStore &cells) const
+{
+    update(cells);
+
+    return m_count;
+}
+
+bool ConnectedComponents::areConnected(const ChunkStore &cells, int from, int to) const
+{
+    int label = labelOf(cells, from);
+
+    return label != -1 && label == labelOf(cells, to);
+}
+
+bool ConnectedComponents::isOutdated() const
+{
+    return m_outdated;
+}
+
+// Labels the changed chunks again and joins the local components of the neighbouring chunks through their common borders.
+// It takes O(chunks * CHUNK_SIZE) plus the flood of every changed chunk.
+void ConnectedComponents::update(const ChunkStore &cells) const
+{
+    if (!m_outdated)
+        return;
+
+    int nodes = 0;
+    m_firstNode.resize(m_chunks.size());
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+    {
+        if (m_chunks.at(chunk).changed)
+            labelChunk(cells, chunk);
+
+        m_firstNode[chunk] = nodes;
+        nodes += m_chunks.at(chunk).seeds.size();
+    }
+
+    m_parent.resize(nodes);
+    m_rank.fill(0, nodes);
+    for (int node = 0; node < nodes; ++node)
+        m_parent[node] = node;
+
+    m_count = nodes;
+    for (int chunk = 0; chunk < m_chunks.size(); ++chunk)
+    {
+        int x, y, width, height;
+        boundsOf(chunk, &x, &y, &width, &height);
+
+        const QVector<quint16>& border = m_chunks.at(chunk).border;
+
+        // Right column of the chunk touches the left column of the next one.
+        if (x + width < m_width)
+        {
+            const QVector<quint16>& next = m_chunks.at(chunk + 1).border;
+            for (int i = 0; i < height; ++i)
+            {
+                quint16 first  = border.at(3 * CHUNK_SIZE + i);
+                quint16 second = next.at(2 * CHUNK_SIZE + i);
+
+                if (first != NONE && second != NONE && unite(m_firstNode[chunk] + first, m_firstNode[chunk + 1] + second))
+                    --m_count;
+            }
+        }
+
+        // Bottom row of the chunk touches the top row of the chunk below.
+        if (y + height < m_height)
+        {
+            int below = chunk + m_chunksInRow;
+            const QVector<quint16>& next = m_chunks.at(below).border;
+            for (int i = 0; i < width; ++i)
+            {
+                quint16 first  = border.at(CHUNK_SIZE + i);
+                quint16 second = next.at(i);
+
+                if (first != NONE && second != NONE && unite(m_firstNode[chunk] + first, m_firstNode[below] + second))
+                    --m_count;
+            }
+        }
+    }
+
+    m_outdated = false;
+    qDebug() << QString("Connected components. Grid has been relabelled: %1 components.").arg(m_count);
+}
+
+// Flood labelling inside the chunk: local components are numbered in the order of their first cells.
+void ConnectedComponents::labelChunk(const ChunkStore &cells, int chunk) const
+{
+    static const int dx[4] = {0, 0, -1, 1};
+    static const int dy[4] = {-1, 1, 0, 0};
+
+    int x, y, width, height;
+    boundsOf(chunk, &x, &y, &width, &height);
+
+    QVector<quint16> local (CHUNK_CELLS, NONE);
+    QVector<int>     stack;
+
+    Chunk& data = m_chunks[chunk];
+    data.seeds.clear();
+    data.changed = false;
+
+    for (int seedY = 0; seedY < height; ++seedY)
+        for (int seedX = 0; seedX < width; ++seedX)
+        {
+            int seed = seedY * CHUNK_SIZE + seedX;
+            if (local.at(seed) != NONE || cells.isFilled(x + seedX, y + seedY))
+                continue;
+
+            quint16 index = data.seeds.size();
+            data.seeds.push_back(seed);
+            local[seed] = index;
+            stack.push_back(seed);
+
+            while (!stack.isEmpty())
+            {
+                int offset = stack.last();
+                stack.pop_back();
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    int nx = offset % CHUNK_SIZE + dx[i];
+                    int ny = offset / CHUNK_SIZE + dy[i];
+                    if (nx < 0 || nx >= width || ny < 0 || ny >= height)
+                        continue;
+
+                    int next = ny * CHUNK_SIZE + nx;
+                    if (local.at(next) != NONE || cells.isFilled(x + nx, y + ny))
+                        continue;
+
+                    local[next] = index;
+                    stack.push_back(next);
+                }
+            }
+        }
+
+    data.border.fill(NONE, 4 * CHUNK_SIZE);
+    for (int i = 0; i < width; ++i)
+    {
+        data.border[i]              = local.at(i);
+        data.border[CHUNK_SIZE + i] = local.at((height - 1) * CHUNK_SIZE + i);
+    }
+
+    for (int i = 0; i < height; ++i)
+    {
+        data.border[2 * CHUNK_SIZE + i] = local.at(i * CHUNK_SIZE);
+        data.border[3 * CHUNK_SIZE + i] = local.at(i * CHUNK_SIZE + width - 1);
+    }
+}
+
+// Local component of the unfilled {cell}. The flood from the cell stops at the first border cell, that knows its component.
+// The component, that doesn't reach the border, is found by its first cell.
+int ConnectedComponents::localIndexOf(const ChunkStore &cells, int cell) const
+{
+    static const int dx[4] = {0, 0, -1, 1};
+    static const int dy[4] = {-1, 1, 0, 0};
+
+    int chunk = chunkOf(cell);
+    const Chunk& data = m_chunks.at(chunk);
+    if (data.seeds.size() == 1)
+        return 0;
+
+    int x, y, width, height;
+    boundsOf(chunk, &x, &y, &width, &height);
+
+    QVector<bool> visited (CHUNK_CELLS, false);
+    QVector<int>  stack;
+
+    int start = (cell / m_width - y) * CHUNK_SIZE + cell % m_width - x;
+    int first = start;
+
+    visited[start] = true;
+    stack.push_back(start);
+
+    while (!stack.isEmpty())
+    {
+        int offset = stack.last();
+        stack.pop_back();
+
+        int ox = offset % CHUNK_SIZE;
+        int oy = offset / CHUNK_SIZE;
+
+        if (oy == 0)
+            return data.border.at(ox);
+        if (oy == height - 1)
+            return data.border.at(CHUNK_SIZE + ox);
+        if (ox == 0)
+            return data.border.at(2 * CHUNK_SIZE + oy);
+        if (ox == width - 1)
+            return data.border.at(3 * CHUNK_SIZE + oy);
+
+        first = qMin(first, offset);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int next = (oy + dy[i]) * CHUNK_SIZE + ox + dx[i];
+            if (visited.at(next) || cells.isFilled(x + ox + dx[i], y + oy + dy[i]))
+                continue;
+
+            visited[next] = true;
+            stack.push_back(next);
+        }
+    }
+
+    return std::lower_bound(data.seeds.begin(), data.seeds.end(), first) - data.seeds.begin();
+}
+
+int ConnectedComponents::chunkOf(int cell) const
+{
+    return (cell / m_width / CHUNK_SIZE) * m_chunksInRow + cell % m_width / CHUNK_SIZE;
+}
+
+void ConnectedComponents::boundsOf(int chunk, int *x, int *y, int *width, int *height) const
+{
+    *x      = (chunk % m_chunksInRow) * CHUNK_SIZE;
+    *y      = (chunk / m_chunksInRow) * CHUNK_SIZE;
+    *width  = qMin(CHUNK_SIZE, m_width - *x);
+    *height = qMin(CHUNK_SIZE, m_height - *y);
+}
+
+// Finds the root of the {node}'s tree. Every visited node is moved closer to the root (path halving).
+int ConnectedComponents::find(int node) const
+{
+    while (m_parent[node] != node)
+    {
+        m_parent[node] = m_parent[m_parent[node]];
+        node = m_parent[node];
+    }
+
+    return node;
+}
+
+// Joins the trees of two nodes (union by rank). Returns false, if they are already in the same tree.
+bool ConnectedComponents::unite(int first, int second) const
+{
+    first  = find(first);
+    second = find(second);
+
+    if (first == second)
+        return false;
+
+    if (m_rank[first] < m_rank[second])
+        qSwap(first, second);
+
+    m_parent[second] = first;
+    if (m_rank[first] == m_rank[second])
+        ++m_rank[first];
+
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef CONNECTEDCOMPONENTS_H
+#define CONNECTEDCOMPONENTS_H
+
+#include <QVector>
+
+#include "chunkstore.h"
+
+// ConnectedComponents labels every unfilled cell of the grid with the component (island), it belongs to.
+// Two cells have a path between them only if their labels are equal, so unreachable queries are rejected without search.
+// Diagonal steps never cut corners, so diagonal movement doesn't join components: neighbours are up, down, left and right.
+//
+// Components are kept by the chunks of the grid (see ChunkStore), so they take memory for the chunks, not for the cells:
+// - every chunk knows its local components (found by flood labelling inside the chunk) and the local component of every
+//   border cell. Chunks, that were never changed, share the labels of the empty chunk (one component, that holds everything);
+// - local components are joined across the borders of the chunks by union-find, that has one node per local component;
+// - the label of the cell is the root of its local component. In the chunk with several local components it is found
+//   by the flood from the cell, that stops at the border of the chunk.
+// Filling or unfilling the cell marks its chunk as changed. The first query after the edit labels the changed chunks again
+// and joins the chunks anew, so the burst of edits costs one update, and every answer is exact.
+// Filled flags are not copied: they are read from the cells of the grid, that are passed to the queries.
+class ConnectedComponents
+{
+public:
+    ConnectedComponents();
+    ~ConnectedComponents();
+
+    // Prepares labels for the grid of {width} x {height} cells. All the cells are unfilled.
+    void reset (int width, int height);
+
+    // Marks the chunk of the {cell}, that was filled or unfilled.
+    void change (int cell);
+
+    // Label of the component, that {cell} belongs to, or -1 for filled cells.
+    // Labels are valid until the next change of the grid.
+    int  labelOf        (const ChunkStore& cells, int cell) const;
+    int  componentCount (const ChunkStore& cells) const;
+    bool areConnected   (const ChunkStore& cells, int from, int to) const;
+
+    // Queries update the outdated components, so they are not safe to run from several threads at once.
+    bool isOutdated () const;
+
+private:
+    static constexpr int     CHUNK_SIZE  = ChunkStore::CHUNK_SIZE;
+    static constexpr int     CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+    static constexpr quint16 NONE        = 0xFFFF;
+
+    // {seeds} are the first cells of the local components (offsets in the chunk, in the row order).
+    // {border} is the local component of every border cell (NONE for filled ones): top row, bottom row, left column, right column.
+    struct Chunk
+    {
+        QVector<quint16> seeds;
+        QVector<quint16> border;
+        bool             changed = false;
+    };
+
+    void update       (const ChunkStore& cells) const;
+    void labelChunk   (const ChunkStore& cells, int chunk) const;
+    int  localIndexOf (const ChunkStore& cells, int cell) const;
+    int  chunkOf      (int cell) const;
+    // Writes the first cell of the {chunk} and its size (chunks at the right and bottom sides of the grid may be smaller).
+    void boundsOf     (int chunk, int* x, int* y, int* width, int* height) const;
+
+    int  find  (int node) const;
+    bool unite (int first, int second) const;
+
+    int m_width       = 0;
+    int m_height      = 0;
+    int m_chunksInRow = 0;
+
+    // Union-find forest over the local components: nodes of the chunk start at its {m_firstNode}.
+    // {m_parent} of the root is the root itself. Rank never exceeds log2 of the nodes count, so it takes one byte.
+    mutable QVector<Chunk>  m_chunks;
+    mutable QVector<int>    m_firstNode;
+    mutable QVector<int>    m_parent;
+    mutable QVector<quint8> m_rank;
+    mutable int             m_count    = 0;
+    mutable bool            m_outdated = false;
+};
+
+#endif // CONNECTEDCOMPONENTS_H
@@ -0,0 +1,239 @@
+#include "cooperativesearch.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <functional>
+
+// Heap orders states by {cost + estimate} and resolves equal ones in favour of the state, that is further from the start.
+static inline qint64 priorityFor(int cost, int estimate)
+{
+    return (qint64(cost + estimate) << 32) - cost;
+}
+
+static inline int cellOf(quint64 state)
+{
+    return int(state & 0xFFFFFFFF);
+}
+
+static inline int timeOf(quint64 state)
+{
+    return int(state >> 32);
+}
+
+CooperativeSearch::CooperativeSearch(int maxTime)
+{
+    setMaxTime(maxTime);
+}
+
+CooperativeSearch::~CooperativeSearch()
+{
+
+}
+
+int CooperativeSearch::maxTime() const
+{
+    return m_maxTime;
+}
+
+void CooperativeSearch::setMaxTime(int steps)
+{
+    m_maxTime = qMax(steps, 1);
+}
+
+QVector<QVector<Node>> CooperativeSearch::plan(const Grid &grid, const QVector<QPair<Node, Node>> &agents)
+{
+    // Every agent is searched against the reservations of the agents before it, then its own path is reserved:
+    // every cell at its time step and the last cell (the goal) from the arrival on.
+    // Agents, that are not planned yet, stand at their starts, so the agents before them go around.
+
+    QVector<QVector<Node>> result (agents.size());
+
+    m_reservations.clear();
+    m_expandedCount = 0;
+    m_failedCount = 0;
+
+    // Grid has changed since these searches were started.
+    for (int i = m_estimates.size() - 1; i >= 0; --i)
+        if (!m_estimates[i].isValidFor(grid))
+            m_estimates.removeAt(i);
+
+    QVector<bool> traceable (agents.size());
+    for (int agent = 0; agent < agents.size(); ++agent)
+    {
+        const Node& from = agents.at(agent).first;
+        const Node& to   = agents.at(agent).second;
+
+        traceable[agent] = grid.contains(from) && grid.contains(to) && !grid.isFilled(from) && !grid.isFilled(to);
+        if (traceable[agent])
+            m_reservations.park(grid.indexOf(from), 0, agent);
+    }
+
+    for (int agent = 0; agent < agents.size(); ++agent)
+    {
+        const Node& from = agents.at(agent).first;
+        const Node& to   = agents.at(agent).second;
+
+        if (!traceable[agent])
+        {
+            qDebug() << QString("Shortest path. Cooperative A*: agent %1 can't be traced.").arg(agent);
+            ++m_failedCount;
+            continue;
+        }
+
+        int start = grid.indexOf(from);
+        int goal  = grid.indexOf(to);
+        m_reservations.unpark(start);
+
+        QVector<int> cells;
+        if (grid.areConnected(from, to))
+            cells = search(grid, agent, start, goal);
+
+        if (cells.isEmpty())
+        {
+            qDebug() << QString("Shortest path. Cooperative A*: agent %1 can't reach %2 in %3 steps, it waits.").arg(agent).arg(to.toString()).arg(m_maxTime);
+            ++m_failedCount;
+            cells.push_back(start);
+        }
+
+        for (int time = 0; time < cells.size(); ++time)
+        {
+            m_reservations.reserve(cells[time], time, agent);
+            result[agent].push_back(grid.nodeAt(cells[time]));
+        }
+
+        m_reservations.park(cells.last(), cells.size() - 1, agent);
+    }
+
+    qDebug() << QString("Shortest path. Cooperative A*: %1 agents planned, %2 failed. Expanded states: %3.")
+                .arg(agents.size()).arg(m_failedCount).arg(m_expandedCount);
+
+    return result;
+}
+
+const ReservationTable &CooperativeSearch::reservations() const
+{
+    return m_reservations;
+}
+
+int CooperativeSearch::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+int CooperativeSearch::failedCount() const
+{
+    return m_failedCount;
+}
+
+QVector<int> CooperativeSearch::search(const Grid &grid, int agent, int start, int goal)
+{
+    // A* over {cell, time} states. From every state the agent moves to an unfilled neighbour or waits in its cell
+    // (waiting costs as much as the cheapest step, so that the agent doesn't wait without a reason).
+    // The goal is reached only if the agent may stay there: nobody crosses it later.
+
+    QVector<int> result;
+
+    // The goal is taken by the other agent forever: no search would reach it.
+    int parked = m_reservations.agentAt(goal, m_maxTime);
+    if (parked != -1 && parked != agent)
+        return result;
+
+    ReverseSearch& estimates = estimatesFor(grid, goal);
+    estimates.setOrigin(grid, start);
+
+    if (estimates.costOf(grid, start) == -1)
+        return result;
+
+    m_cost.clear();
+    m_parent.clear();
+    m_open.clear();
+
+    // Waiting costs as the cheapest step, but never nothing: free waits would be expanded up to the time limit first.
+    int wait_cost = qMax(grid.minimumWeight(), 1);
+
+    quint64 root = ReservationTable::keyOf(start, 0);
+    m_cost.insert(root, 0);
+    m_open.push_back(qMakePair(priorityFor(0, estimates.costOf(grid, start)), root));
+
+    int neighbours[Grid::MAX_NEIGHBOURS + 1];
+    while (!m_open.isEmpty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<QPair<qint64, quint64>>());
+        QPair<qint64, quint64> entry = m_open.takeLast();
+
+        quint64 state = entry.second;
+        int cell = cellOf(state);
+        int time = timeOf(state);
+        int cost = m_cost.value(state);
+
+        // The state was queued again with lower cost, this entry is stale.
+        if (entry.first != priorityFor(cost, estimates.costOf(grid, cell)))
+            continue;
+
+        ++m_expandedCount;
+
+        if (cell == goal && m_reservations.canPark(goal, time, agent))
+        {
+            for (quint64 current = state; current != root; current = m_parent.value(current))
+                result.push_back(cellOf(current));
+
+            result.push_back(start);
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+        if (time >= m_maxTime)
+            continue;
+
+        int count = grid.unfilledNeighboursOf(cell, neighbours);
+        neighbours[count++] = cell;
+
+        for (int i = 0; i < count; ++i)
+        {
+            int next = neighbours[i];
+            if (!m_reservations.canMove(cell, next, time, agent))
+                continue;
+
+            int estimate = estimates.costOf(grid, next);
+            if (estimate == -1)
+                continue;
+
+            quint64 next_state = ReservationTable::keyOf(next, time + 1);
+            int     next_cost  = cost + (next == cell ? wait_cost : grid.stepCost(cell, next));
+
+            int known = m_cost.value(next_state, -1);
+            if (known != -1 && known <= next_cost)
+                continue;
+
+            m_cost.insert(next_state, next_cost);
+            m_parent.insert(next_state, state);
+
+            m_open.push_back(qMakePair(priorityFor(next_cost, estimate), next_state));
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<QPair<qint64, quint64>>());
+        }
+    }
+
+    return result;
+}
+
+ReverseSearch &CooperativeSearch::estimatesFor(const Grid &grid, int goal)
+{
+    for (int i = 0; i < m_estimates.size(); ++i)
+    {
+        if (m_estimates[i].goal() != goal)
+            continue;
+
+        m_estimates.move(i, 0);
+        return m_estimates.first();
+    }
+
+    if (m_estimates.size() >= GOALS_CAPACITY)
+        m_estimates.removeLast();
+
+    m_estimates.prepend(ReverseSearch());
+    m_estimates.first().reset(grid, goal);
+
+    return m_estimates.first();
+}
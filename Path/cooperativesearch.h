@@ -0,0 +1,72 @@
+#ifndef COOPERATIVESEARCH_H
+#define COOPERATIVESEARCH_H
+
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QPair>
+
+#include "Graph/node.h"
+#include "reservationtable.h"
+#include "reversesearch.h"
+
+class Grid;
+
+// CooperativeSearch plans the paths of several agents, that move at the same time, so that they don't collide
+// (cooperative A*). Agents are planned one by one in order of their priority (the order of the queries).
+// Every agent is searched over the states {cell, time step}: at every step it moves to the neighbouring cell or waits.
+// States, that are taken by the agents planned before it, are skipped (see ReservationTable), and the found path
+// is reserved for the agents planned after it. Agent, that has reached its goal, stays there.
+// Agents, that are not planned yet, stand still at their starts, so the agents planned before them go around.
+//
+// Estimate of the state is the exact cost from its cell to the goal, when there are no other agents (hierarchical cooperative A*):
+// it is computed by the reverse search from the goal (see ReverseSearch), that goes only as far, as the agent asks it to.
+// Reverse searches of the last goals are kept across the plans, until the grid changes. So the search follows the shortest path
+// and opens other states only where the agents before it are in the way.
+//
+// Time is limited by the {maxTime} steps. Agent, that can't reach its goal in time, waits at its start.
+class CooperativeSearch
+{
+public:
+    static constexpr int DEFAULT_MAX_TIME = 256;
+    static constexpr int GOALS_CAPACITY   = 64;
+    CooperativeSearch(int maxTime = DEFAULT_MAX_TIME);
+    ~CooperativeSearch();
+
+    int  maxTime () const;
+    void setMaxTime (int steps);
+
+    // Returns the paths in order of the {agents} ({start, goal} pairs). Node {t} of the path is the cell of the agent
+    // at the time step {t}, so the waiting agent repeats its cell.
+    QVector<QVector<Node>> plan (const Grid& grid, const QVector<QPair<Node, Node>>& agents);
+
+    const ReservationTable& reservations () const;
+
+    // Statistics of the last plan.
+    int expandedCount () const;
+    int failedCount () const;
+
+private:
+    QVector<int> search (const Grid& grid, int agent, int start, int goal);
+
+    // Reverse search of the {goal}, that is valid for the current state of the {grid}.
+    ReverseSearch& estimatesFor (const Grid& grid, int goal);
+
+    int m_maxTime;
+    ReservationTable m_reservations;
+
+    // Search data: the best cost and the previous state of every reached state (both by packed {cell, time} key)
+    // and the heap of open states with their priorities (stale entries are skipped, when popped).
+    QHash<quint64, int>             m_cost;
+    QHash<quint64, quint64>         m_parent;
+    QVector<QPair<qint64, quint64>> m_open;
+
+    // Exact estimates for the last goals. The most recently used one goes first,
+    // the least recently used one is dropped, when there are too many of them.
+    QList<ReverseSearch> m_estimates;
+
+    int m_expandedCount = 0;
+    int m_failedCount = 0;
+};
+
+#endif // COOPERATIVESEARCH_H
@@ -0,0 +1,136 @@
+#include "distancefield.h"
+#include "grid.h"
+
+#include "Graph/priorityqueue.h"
+#include "Graph/bucketqueue.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+DistanceField::DistanceField()
+{
+
+}
+
+DistanceField::~DistanceField()
+{
+
+}
+
+void DistanceField::compute(const Grid &grid, const Node &root)
+{
+    m_root    = root;
+    m_version = grid.version();
+    m_width   = grid.width();
+    m_height  = grid.height();
+
+    m_cost.fill(-1, m_width * m_height);
+    m_parent.fill(-1, m_width * m_height);
+
+    if (!grid.contains(root) || grid.isFilled(root))
+        return;
+
+    // Costs of the steps are small integers, so buckets are used, if the grid allows that.
+    int cells = m_width * m_height;
+    if (grid.maximumStepCost() <= BucketQueue::MAX_STEP)
+    {
+        BucketQueue open (cells, grid.maximumStepCost());
+        flood(grid, grid.indexOf(root), open);
+    }
+    else
+    {
+        PriorityQueue open (cells);
+        flood(grid, grid.indexOf(root), open);
+    }
+}
+
+template <typename Queue>
+void DistanceField::flood(const Grid &grid, int root, Queue &open)
+{
+    // Dijkstra search without the goal: it stops, when all the reachable cells are picked.
+    m_cost[root] = 0;
+    open.push(root, 0);
+
+    int picked = 0;
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        ++picked;
+
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next     = neighbours[i];
+            int new_cost = m_cost[current] + grid.stepCost(current, next);
+
+            if (m_cost[next] != -1 && new_cost >= m_cost[next])
+                continue;
+
+            m_cost[next]   = new_cost;
+            m_parent[next] = current;
+            open.push(next, new_cost);
+        }
+    }
+
+    qDebug() << QString("Shortest path. Distance field from %1 has been computed. Reached cells: %2.").arg(m_root.toString()).arg(picked);
+}
+
+bool DistanceField::isEmpty() const
+{
+    return m_cost.isEmpty();
+}
+
+// Field is valid, while the grid hasn't changed since the field was computed.
+bool DistanceField::isValidFor(const Grid &grid) const
+{
+    return !isEmpty() && m_version == grid.version() && m_width == grid.width() && m_height == grid.height();
+}
+
+const Node &DistanceField::root() const
+{
+    return m_root;
+}
+
+uint DistanceField::version() const
+{
+    return m_version;
+}
+
+bool DistanceField::isReachable(const Node &node) const
+{
+    return costTo(node) != -1;
+}
+
+int DistanceField::costTo(const Node &node) const
+{
+    if (!contains(node))
+        return -1;
+
+    return m_cost[indexOf(node)];
+}
+
+QVector<Node> DistanceField::pathTo(const Node &to) const
+{
+    QVector<Node> result;
+
+    if (!isReachable(to))
+        return result;
+
+    for (int cell = indexOf(to); cell != -1; cell = m_parent[cell])
+        result.push_back(Node(cell % m_width, cell / m_width));
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+bool DistanceField::contains(const Node &node) const
+{
+    return node.x() >= 0 && node.x() < m_width && node.y() >= 0 && node.y() < m_height && !isEmpty();
+}
+
+int DistanceField::indexOf(const Node &node) const
+{
+    return node.y() * m_width + node.x();
+}
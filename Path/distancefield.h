@@ -0,0 +1,49 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+
+class Grid;
+
+// DistanceField holds the costs of the shortest paths from one root cell to every cell of the grid
+// together with the parent of every reached cell (single-source Dijkstra search on the grid).
+// When it is computed, the path from the root to any cell is just a walk through parents, O(path length).
+// Field remembers the version of the grid, it was computed for, so it is known, when it gets outdated.
+class DistanceField
+{
+public:
+    DistanceField();
+    ~DistanceField();
+
+    void compute (const Grid& grid, const Node& root);
+
+    bool isEmpty () const;
+    bool isValidFor (const Grid& grid) const;
+
+    const Node& root () const;
+    uint version () const;
+
+    bool isReachable (const Node& node) const;
+    int  costTo      (const Node& node) const;
+    QVector<Node> pathTo (const Node& to) const;
+
+private:
+    template <typename Queue>
+    void flood (const Grid& grid, int root, Queue& open);
+
+    bool contains (const Node& node) const;
+    int  indexOf  (const Node& node) const;
+
+    Node m_root;
+    uint m_version = 0;
+    int  m_width   = 0;
+    int  m_height  = 0;
+
+    // Per-cell data (indexed by the cell index of the grid): cost is -1 for unreachable cells, parent is -1 for the root.
+    QVector<int> m_cost;
+    QVector<int> m_parent;
+};
+
+#endif // DISTANCEFIELD_H
@@ -0,0 +1,66 @@
+#include "distancefieldcache.h"
+#include "grid.h"
+
+#include <QDebug>
+
+DistanceFieldCache::DistanceFieldCache(int capacity)
+{
+    m_capacity = qMax(1, capacity);
+}
+
+DistanceFieldCache::~DistanceFieldCache()
+{
+
+}
+
+int DistanceFieldCache::capacity() const
+{
+    return m_capacity;
+}
+
+void DistanceFieldCache::setCapacity(int capacity)
+{
+    m_capacity = qMax(1, capacity);
+
+    while (m_fields.size() > m_capacity)
+        m_fields.removeLast();
+}
+
+void DistanceFieldCache::clear()
+{
+    m_fields.clear();
+}
+
+const DistanceField &DistanceFieldCache::fieldFor(const Grid &grid, const Node &root)
+{
+    for (int i = 0; i < m_fields.size(); ++i)
+    {
+        if (m_fields[i].root() != root)
+            continue;
+
+        // Grid has changed since the field was computed.
+        if (!m_fields[i].isValidFor(grid))
+        {
+            m_fields.removeAt(i);
+            break;
+        }
+
+        m_fields.move(i, 0);
+        return m_fields.first();
+    }
+
+    qDebug() << QString("Shortest path. There is no distance field for %1 in the cache.").arg(root.toString());
+
+    if (m_fields.size() >= m_capacity)
+        m_fields.removeLast();
+
+    m_fields.prepend(DistanceField());
+    m_fields.first().compute(grid, root);
+
+    return m_fields.first();
+}
+
+QVector<Node> DistanceFieldCache::shortestPath(const Grid &grid, const Node &from, const Node &to)
+{
+    return fieldFor(grid, from).pathTo(to);
+}
@@ -0,0 +1,34 @@
+#ifndef DISTANCEFIELDCACHE_H
+#define DISTANCEFIELDCACHE_H
+
+#include <QList>
+
+#include "distancefield.h"
+
+// DistanceFieldCache keeps distance fields of the last few roots, that were asked for.
+// Units tend to ask many paths from the same cell (e.g. while the cursor moves over the map),
+// so the field is computed once per root and every next path from it is a walk through parents.
+// Fields are keyed by (root, version of the grid): any change of the grid makes them outdated, and they are computed again.
+class DistanceFieldCache
+{
+public:
+    static constexpr int DEFAULT_CAPACITY = 4;
+    DistanceFieldCache(int capacity = DEFAULT_CAPACITY);
+    ~DistanceFieldCache();
+
+    int  capacity () const;
+    void setCapacity (int capacity);
+    void clear ();
+
+    // Returns the field of the {root}, that is valid for the current state of the {grid}.
+    const DistanceField& fieldFor (const Grid& grid, const Node& root);
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to);
+
+private:
+    // The most recently used field goes first. The least recently used one is replaced, when the cache is full.
+    QList<DistanceField> m_fields;
+    int                  m_capacity;
+};
+
+#endif // DISTANCEFIELDCACHE_H
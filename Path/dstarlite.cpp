@@ -0,0 +1,241 @@
+#include "dstarlite.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <limits>
+
+// Cost of the cell, that has no known path to the goal.
+static const int INFINITE_COST = 0x3FFFFFFF;
+
+DStarLite::DStarLite()
+{
+
+}
+
+DStarLite::~DStarLite()
+{
+
+}
+
+QVector<Node> DStarLite::shortestPath(const Grid &grid, const Node &from, const Node &to, const Heuristic &heuristic)
+{
+    m_pathCost = -1;
+    m_expandedCount = 0;
+
+    if (!grid.contains(from) || !grid.contains(to) || grid.isFilled(from) || grid.isFilled(to))
+    {
+        qDebug() << "Shortest path. D* Lite: start or goal node can't be traced.";
+        return QVector<Node>();
+    }
+
+    int start = grid.indexOf(from);
+    int goal  = grid.indexOf(to);
+
+    if (goal != m_goal || !repair(grid, start, heuristic))
+        initialize(grid, start, goal, heuristic);
+
+    computeShortestPath(grid);
+
+    if (m_cost[m_start] == INFINITE_COST)
+    {
+        qDebug() << QString("Shortest path. D* Lite: node %1 can't be reached from node %2.").arg(to.toString()).arg(from.toString());
+        return QVector<Node>();
+    }
+
+    m_pathCost = m_cost[m_start];
+    qDebug() << QString("Shortest path. D* Lite: path found. Cost: %1. Expanded nodes: %2.").arg(m_pathCost).arg(m_expandedCount);
+
+    return tracePath(grid);
+}
+
+int DStarLite::pathCost() const
+{
+    return m_pathCost;
+}
+
+int DStarLite::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+// Forgets all the costs. Only the goal is consistent: it costs nothing to get there from itself.
+void DStarLite::initialize(const Grid &grid, int start, int goal, const Heuristic &heuristic)
+{
+    int count = grid.width() * grid.height();
+
+    m_width     = grid.width();
+    m_height    = grid.height();
+    m_diagonal  = grid.diagonalMovement();
+    m_version   = grid.version();
+    m_start     = start;
+    m_goal      = goal;
+    m_heuristic = heuristic;
+    m_keyModifier = 0;
+
+    m_cost.fill(INFINITE_COST, count);
+    m_lookahead.fill(INFINITE_COST, count);
+    m_open.reset(count);
+
+    m_lookahead[goal] = 0;
+    m_open.push(goal, keyOf(grid, goal));
+}
+
+// Brings the kept search state up to date with the grid and the new position of the unit.
+// Returns false, if the state can't be repaired and the search has to start over.
+bool DStarLite::repair(const Grid &grid, int start, const Heuristic &heuristic)
+{
+    if (m_cost.isEmpty() || m_width != grid.width() || m_height != grid.height() || m_diagonal != grid.diagonalMovement())
+        return false;
+
+    if (m_heuristic.type() != heuristic.type() || m_heuristic.minimumWeight() != heuristic.minimumWeight())
+        return false;
+
+    QVector<int> changed;
+    if (!grid.changedCellsSince(m_version, changed))
+        return false;
+
+    // Estimates are made from the unit's position. When the unit moves, they shrink at most by the distance it has gone,
+    // so the keys of queued cells stay lower bounds, if all the new keys are raised by that distance.
+    if (start != m_start)
+    {
+        m_keyModifier += m_heuristic.estimate(grid.nodeAt(m_start), grid.nodeAt(start));
+        m_start = start;
+    }
+
+    // Changed cell changes the steps to it and from it, and (with diagonal movement) the diagonal steps around its corners.
+    // All of them start and end in the 3x3 square around the cell.
+    foreach (int cell, changed)
+    {
+        int x = cell % m_width;
+        int y = cell / m_width;
+
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                if (x + dx >= 0 && x + dx < m_width && y + dy >= 0 && y + dy < m_height)
+                    updateCell(grid, cell + dy * m_width + dx);
+    }
+
+    m_version = grid.version();
+    return true;
+}
+
+void DStarLite::computeShortestPath(const Grid &grid)
+{
+    // 1. Take the inconsistent cell with the lowest key. If its key is outdated (the unit has moved), queue it again.
+    // 2. Overconsistent cell (cost > lookahead) got cheaper: accept the lookahead and update its predecessors.
+    // 3. Underconsistent cell (cost < lookahead) got more expensive: forget its cost and update it with its predecessors.
+    // Search stops, when the unit's cell is consistent and no queued cell may change it.
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!m_open.isEmpty())
+    {
+        if (m_open.topPriority() >= keyOf(grid, m_start) && m_cost[m_start] == m_lookahead[m_start])
+            break;
+
+        int    current = m_open.top();
+        qint64 key     = keyOf(grid, current);
+        if (m_open.topPriority() < key)
+        {
+            m_open.push(current, key);
+            continue;
+        }
+
+        m_open.pop();
+        ++m_expandedCount;
+
+        if (m_cost[current] > m_lookahead[current])
+            m_cost[current] = m_lookahead[current];
+        else
+        {
+            m_cost[current] = INFINITE_COST;
+            updateCell(grid, current);
+        }
+
+        int count = neighboursOf(grid, current, neighbours);
+        for (int i = 0; i < count; ++i)
+            updateCell(grid, neighbours[i]);
+    }
+}
+
+// Recomputes the lookahead of the {cell} and queues it, if it is inconsistent.
+void DStarLite::updateCell(const Grid &grid, int cell)
+{
+    if (cell != m_goal)
+        m_lookahead[cell] = lookahead(grid, cell);
+
+    if (m_open.contains(cell))
+        m_open.remove(cell);
+
+    if (m_cost[cell] != m_lookahead[cell])
+        m_open.push(cell, keyOf(grid, cell));
+}
+
+// The cheapest cost to the goal through one of the neighbours.
+int DStarLite::lookahead(const Grid &grid, int cell) const
+{
+    int result = INFINITE_COST;
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    int count = neighboursOf(grid, cell, neighbours);
+    for (int i = 0; i < count; ++i)
+        if (m_cost[neighbours[i]] != INFINITE_COST)
+            result = qMin(result, grid.stepCost(cell, neighbours[i]) + m_cost[neighbours[i]]);
+
+    return result;
+}
+
+// Key orders the cells by {cost + estimate from the unit}, equal ones are resolved in favour of the cheaper cell.
+qint64 DStarLite::keyOf(const Grid &grid, int cell) const
+{
+    int cost = qMin(m_cost[cell], m_lookahead[cell]);
+    if (cost == INFINITE_COST)
+        return std::numeric_limits<qint64>::max();
+
+    int estimate = m_heuristic.estimate(grid.nodeAt(m_start), grid.nodeAt(cell));
+    return (qint64(cost + estimate + m_keyModifier) << 32) + cost;
+}
+
+int DStarLite::neighboursOf(const Grid &grid, int cell, int *result) const
+{
+    if (grid.isFilled(cell))
+        return 0;
+
+    return grid.unfilledNeighboursOf(cell, result);
+}
+
+// Path goes from the unit to the goal, every step is made to the neighbour, that gives the cheapest cost to the goal.
+QVector<Node> DStarLite::tracePath(const Grid &grid) const
+{
+    QVector<Node> result;
+    result.push_back(grid.nodeAt(m_start));
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    for (int cell = m_start; cell != m_goal && result.size() <= m_cost.size(); )
+    {
+        int next = -1;
+        int best = INFINITE_COST;
+
+        int count = neighboursOf(grid, cell, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            if (m_cost[neighbours[i]] == INFINITE_COST)
+                continue;
+
+            int cost = grid.stepCost(cell, neighbours[i]) + m_cost[neighbours[i]];
+            if (cost < best)
+            {
+                best = cost;
+                next = neighbours[i];
+            }
+        }
+
+        if (next == -1)
+            return QVector<Node>();
+
+        cell = next;
+        result.push_back(grid.nodeAt(cell));
+    }
+
+    return result;
+}
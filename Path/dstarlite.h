@@ -0,0 +1,66 @@
+#ifndef DSTARLITE_H
+#define DSTARLITE_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+#include "Graph/priorityqueue.h"
+#include "heuristic.h"
+
+class Grid;
+
+// DStarLite is incremental search for the unit, that follows the path to the same goal while the map changes around it
+// (doors are opened and closed, cells are filled, unfilled or get other weights).
+// Search goes backward, from the goal to the unit, so that its results stay valid, when the unit moves.
+// Every cell keeps its cost to the goal {g} and one-step lookahead {rhs} (the best cost through its neighbours).
+// Cells, where they differ, are inconsistent and wait in the queue, ordered like in A* towards the unit.
+//
+// Search state is kept between the queries. When the grid changes (see Grid::changedCellsSince), only the cells around
+// the changed ones get their {rhs} recomputed, and the search repairs only the part of costs, that became wrong.
+// Moving unit doesn't invalidate anything: keys are just raised by the distance, it has gone ({m_keyModifier}).
+// New goal, size, movement rules or heuristic start the search from scratch.
+class DStarLite
+{
+public:
+    DStarLite();
+    ~DStarLite();
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to, const Heuristic& heuristic);
+
+    // Statistics of the last search.
+    int pathCost () const;
+    int expandedCount () const;
+
+private:
+    void initialize (const Grid& grid, int start, int goal, const Heuristic& heuristic);
+    bool repair     (const Grid& grid, int start, const Heuristic& heuristic);
+
+    void computeShortestPath (const Grid& grid);
+    void updateCell (const Grid& grid, int cell);
+    int  lookahead  (const Grid& grid, int cell) const;
+    qint64 keyOf    (const Grid& grid, int cell) const;
+
+    // Writes the cells, that are connected with {cell} by a step (both ways, the costs differ), and returns their count.
+    int neighboursOf (const Grid& grid, int cell, int* result) const;
+
+    QVector<Node> tracePath (const Grid& grid) const;
+
+    // Grid and goal, the search state was built for.
+    int  m_width    = -1;
+    int  m_height   = -1;
+    bool m_diagonal = false;
+    uint m_version  = 0;
+    int  m_goal     = -1;
+    int  m_start    = -1;
+    int  m_keyModifier = 0;
+    Heuristic m_heuristic;
+
+    QVector<int>  m_cost;
+    QVector<int>  m_lookahead;
+    PriorityQueue m_open;
+
+    int m_pathCost = -1;
+    int m_expandedCount = 0;
+};
+
+#endif // DSTARLITE_H
@@ -0,0 +1,282 @@
+#include "flowfield.h"
+#include "grid.h"
+
+#include <QDebug>
+#include <QSet>
+
+// Table of 8 steps, the direction of the cell is the index in it.
+static const int STEP_X[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int STEP_Y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// Direction of the step by its offset: index is (dy + 1) * 3 + (dx + 1).
+static const qint8 DIRECTION_OF[9] = {5, 6, 7, 4, -1, 0, 3, 2, 1};
+
+FlowField::FlowField()
+{
+
+}
+
+FlowField::~FlowField()
+{
+
+}
+
+void FlowField::compute(const Grid &grid, const Node &goal)
+{
+    m_goal     = goal;
+    m_version  = grid.version();
+    m_width    = grid.width();
+    m_height   = grid.height();
+    m_diagonal = grid.diagonalMovement();
+    m_updatedCount = 0;
+
+    int count = m_width * m_height;
+    m_cost.fill(-1, count);
+    m_direction.fill(-1, count);
+    m_open.reset(count);
+
+    if (!grid.contains(goal) || grid.isFilled(goal))
+        return;
+
+    m_cost[indexOf(goal)] = 0;
+    m_open.push(indexOf(goal), 0);
+    flood(grid);
+
+    qDebug() << QString("Shortest path. Flow field to %1 has been computed. Reached cells: %2.").arg(m_goal.toString()).arg(m_updatedCount);
+}
+
+bool FlowField::update(const Grid &grid)
+{
+    if (isEmpty())
+        return false;
+
+    m_updatedCount = 0;
+    if (isValidFor(grid))
+        return true;
+
+    QVector<int> changed;
+    if (m_width != grid.width() || m_height != grid.height() || m_diagonal != grid.diagonalMovement()
+            || !grid.changedCellsSince(m_version, changed))
+    {
+        compute(grid, m_goal);
+        return false;
+    }
+
+    QVector<int> invalid;
+    invalidate(changed, invalid);
+
+    // Every invalid cell starts with the best step to the valid neighbour: costs of the valid cells weren't changed by the edits,
+    // so the cell, that is the last invalid one on its new shortest path, gets its exact cost here.
+    // The search from these cells finds the rest, and the valid cells, that got cheaper paths through them, are updated too.
+    int goal = indexOf(m_goal);
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    foreach (int cell, invalid)
+    {
+        if (grid.isFilled(cell))
+            continue;
+
+        if (cell == goal)
+        {
+            m_cost[cell] = 0;
+            m_open.push(cell, 0);
+            continue;
+        }
+
+        int count = grid.unfilledNeighboursOf(cell, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next = neighbours[i];
+            if (m_cost[next] == -1)
+                continue;
+
+            int cost = grid.stepCost(cell, next) + m_cost[next];
+            if (m_cost[cell] != -1 && cost >= m_cost[cell])
+                continue;
+
+            m_cost[cell] = cost;
+            setNext(cell, next);
+        }
+
+        if (m_cost[cell] != -1)
+            m_open.push(cell, m_cost[cell]);
+    }
+
+    flood(grid);
+    m_version = grid.version();
+
+    qDebug() << QString("Shortest path. Flow field to %1 has been updated. Changed cells: %2, invalidated: %3, updated: %4.")
+                .arg(m_goal.toString()).arg(changed.size()).arg(invalid.size()).arg(m_updatedCount);
+
+    return true;
+}
+
+// Dijkstra search against the steps from the queued cells: the step from {neighbour} to {cell} costs the weight of the {cell}.
+void FlowField::flood(const Grid &grid)
+{
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!m_open.isEmpty())
+    {
+        int cell = m_open.pop();
+        ++m_updatedCount;
+
+        int count = grid.unfilledNeighboursOf(cell, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int neighbour = neighbours[i];
+            int cost      = m_cost[cell] + grid.stepCost(neighbour, cell);
+
+            if (m_cost[neighbour] != -1 && cost >= m_cost[neighbour])
+                continue;
+
+            m_cost[neighbour] = cost;
+            setNext(neighbour, cell);
+            m_open.push(neighbour, cost);
+        }
+    }
+}
+
+void FlowField::invalidate(const QVector<int> &changed, QVector<int> &invalid)
+{
+    // Changed cell changes the steps to it and from it, and (with diagonal movement) the diagonal steps around its corners.
+    // All of them start in the 3x3 square around the cell. Cells, whose steps lead into the invalid cell, are invalid too.
+    // Marks keep every cell listed once. They are kept in the set, so the update costs as much as the invalid region.
+    QSet<int> marked;
+    marked.reserve(changed.size() * 9);
+
+    foreach (int cell, changed)
+    {
+        int x = cell % m_width;
+        int y = cell / m_width;
+
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                if (x + dx >= 0 && x + dx < m_width && y + dy >= 0 && y + dy < m_height && !marked.contains(cell + dy * m_width + dx))
+                {
+                    marked.insert(cell + dy * m_width + dx);
+                    invalid.push_back(cell + dy * m_width + dx);
+                }
+    }
+
+    for (int i = 0; i < invalid.size(); ++i)
+    {
+        int cell = invalid[i];
+        int x    = cell % m_width;
+        int y    = cell / m_width;
+
+        for (int direction = 0; direction < 8; ++direction)
+        {
+            int nx = x + STEP_X[direction];
+            int ny = y + STEP_Y[direction];
+            if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height)
+                continue;
+
+            int neighbour = ny * m_width + nx;
+            if (!marked.contains(neighbour) && nextOf(neighbour) == cell)
+            {
+                marked.insert(neighbour);
+                invalid.push_back(neighbour);
+            }
+        }
+    }
+
+    foreach (int cell, invalid)
+    {
+        m_cost[cell] = -1;
+        m_direction[cell] = -1;
+    }
+}
+
+bool FlowField::isEmpty() const
+{
+    return m_cost.isEmpty();
+}
+
+// Field is valid, while the grid hasn't changed since the field was computed or updated.
+bool FlowField::isValidFor(const Grid &grid) const
+{
+    return !isEmpty() && m_version == grid.version() && m_width == grid.width() && m_height == grid.height()
+            && m_diagonal == grid.diagonalMovement();
+}
+
+const Node &FlowField::goal() const
+{
+    return m_goal;
+}
+
+uint FlowField::version() const
+{
+    return m_version;
+}
+
+bool FlowField::isReachable(const Node &node) const
+{
+    return costFrom(node) != -1;
+}
+
+int FlowField::costFrom(const Node &node) const
+{
+    if (!contains(node))
+        return -1;
+
+    return m_cost[indexOf(node)];
+}
+
+QPoint FlowField::directionAt(const Node &node) const
+{
+    if (!contains(node) || m_direction[indexOf(node)] == -1)
+        return QPoint(0, 0);
+
+    int direction = m_direction[indexOf(node)];
+    return QPoint(STEP_X[direction], STEP_Y[direction]);
+}
+
+Node FlowField::nextStep(const Node &node) const
+{
+    QPoint direction = directionAt(node);
+    return Node(node.x() + direction.x(), node.y() + direction.y());
+}
+
+QVector<Node> FlowField::pathFrom(const Node &node) const
+{
+    QVector<Node> result;
+
+    if (!isReachable(node))
+        return result;
+
+    for (int cell = indexOf(node); cell != -1; cell = nextOf(cell))
+        result.push_back(Node(cell % m_width, cell / m_width));
+
+    return result;
+}
+
+int FlowField::updatedCount() const
+{
+    return m_updatedCount;
+}
+
+bool FlowField::contains(const Node &node) const
+{
+    return node.x() >= 0 && node.x() < m_width && node.y() >= 0 && node.y() < m_height && !isEmpty();
+}
+
+int FlowField::indexOf(const Node &node) const
+{
+    return node.y() * m_width + node.x();
+}
+
+int FlowField::nextOf(int cell) const
+{
+    int direction = m_direction[cell];
+    if (direction == -1)
+        return -1;
+
+    return cell + STEP_Y[direction] * m_width + STEP_X[direction];
+}
+
+void FlowField::setNext(int cell, int next)
+{
+    int dx = next % m_width - cell % m_width;
+    int dy = next / m_width - cell / m_width;
+
+    m_direction[cell] = DIRECTION_OF[(dy + 1) * 3 + (dx + 1)];
+}
@@ -0,0 +1,75 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <QVector>
+#include <QPoint>
+
+#include "Graph/node.h"
+#include "Graph/priorityqueue.h"
+
+class Grid;
+
+// FlowField leads any number of units to one goal (f.e. all the creatures, that chase the player or run to the same item).
+// It is computed by single Dijkstra search from the goal against the steps, so every cell gets its integration cost
+// (the cost of the cheapest path from it to the goal) and the direction of the first step of that path.
+// Unit reads its next step in O(1) instead of running its own search.
+//
+// When a few cells change (see Grid::changedCellsSince), only the cells, whose paths went through the changed steps,
+// lose their costs, and the search is run again from the border of that region. Other cells keep their costs and directions.
+class FlowField
+{
+public:
+    FlowField();
+    ~FlowField();
+
+    void compute (const Grid& grid, const Node& goal);
+
+    // Brings the field up to date with the {grid}. Returns false, if it couldn't be repaired and was computed from scratch.
+    bool update (const Grid& grid);
+
+    bool isEmpty () const;
+    bool isValidFor (const Grid& grid) const;
+
+    const Node& goal () const;
+    uint version () const;
+
+    bool isReachable (const Node& node) const;
+    int  costFrom    (const Node& node) const;
+
+    // Direction of the first step from the {node} ({0, 0} at the goal and in the cells, that can't reach it).
+    QPoint directionAt (const Node& node) const;
+
+    // The cell, unit moves to from the {node}. Unit, that can't move, stays in its cell.
+    Node nextStep (const Node& node) const;
+    QVector<Node> pathFrom (const Node& node) const;
+
+    // Statistics of the last compute or update.
+    int updatedCount () const;
+
+private:
+    void flood (const Grid& grid);
+
+    // Forgets the costs of the cells around the {changed} ones and of all the cells, whose steps lead through them.
+    void invalidate (const QVector<int>& changed, QVector<int>& invalid);
+
+    bool contains (const Node& node) const;
+    int  indexOf  (const Node& node) const;
+    int  nextOf   (int cell) const;
+    void setNext  (int cell, int next);
+
+    Node m_goal;
+    uint m_version  = 0;
+    int  m_width    = 0;
+    int  m_height   = 0;
+    bool m_diagonal = false;
+
+    // Per-cell data (indexed by the cell index of the grid): cost is -1 for the cells, that can't reach the goal,
+    // direction is the index in the table of 8 steps (-1 at the goal and in unreachable cells).
+    QVector<int>   m_cost;
+    QVector<qint8> m_direction;
+    PriorityQueue  m_open;
+
+    int m_updatedCount = 0;
+};
+
+#endif // FLOWFIELD_H
@@ -1,338 +1,610 @@
-#include <QTextStream>
-#include <QFile>
-#include <QSize>
-#include <QPoint>
-
-#include "grid.h"
-
-Grid::Grid(const QSize& size)
-{
-    qDebug() << "in Grid constructor";
-
-    m_size = size;    
-
-    initialize();
-    generateNodes();
-}
-
-Grid::~Grid()
-{
-
-}
-
-Graph Grid::makeGraph() const
-{
-    // 1. Add all the existing nodes into the resulting graph.
-    // 2. Add all the existing edges between unfilled nodes into graph. For this we need look through all the nodes:
-    //    - Do nothing, if it is already filled.
-    //    - Check all the neighbour node for each of the nodes in the graph and add connecting edges for them.
-
-    Graph result;
-
-    // add nodes
-    foreach (Node node, nodes())
-        result.addNode(node);
-
-    // add edges
-    foreach (Node node, result.nodes())
-    {
-        if (isFilled(node))
-            continue;
-
-        QVector<Node> neighbour_nodes = unfilledNeighbourNodesFor(node);
-        foreach (Node neighbour, neighbour_nodes)
-        {
-            result.addEdge(node, neighbour, m_weights[neighbour]);
-            result.addEdge(neighbour, node, m_weights[node]);
-        }
-    }
-
-    qDebug() << "Shortest path. Graph was generated: ";
-    qDebug() << "Shortest path. Nodes: " << result.nodes().size();
-    qDebug() << "Shortest path. Edges: " << result.edges().size();
-
-    return result;
-}
-
-void Grid::initialize()
-{
-    m_nodes    = QVector<QVector<Node>>(m_size.width()*m_size.height());
-    m_isFilled = QMap<Node,bool>();
-    m_weights  = QMap<Node, int>();    
-}
-
-void Grid::generateNodes()
-{
-    qDebug() << "Grid::generateNodes";
-    qDebug() << "Node is empty: " << m_nodes.isEmpty();
-
-    m_nodes.clear();
-    m_nodes.resize(m_size.width()*m_size.height());
-
-    // Do nothing for empty grids
-    if (m_nodes.size() == 0)
-        return;
-
-    // Fill grid with 2d nodes
-    for (int i = 0; i < m_size.width(); ++i)
-    {
-        // fill the column
-        QVector<Node> node_column;
-        for (int j = 0; j < m_size.height(); ++j)
-            node_column.push_back(Node(i,j));
-
-        // add it to list
-        m_nodes.push_back(node_column);
-    }
-
-    // mark all the nodes as unfilled
-    foreach (Node node, nodes())
-        unfill(node);
-
-    qDebug() << "Nodes size: " << m_nodes.size();
-}
-
-Graph Grid::graph() const
-{
-    return makeGraph();
-}
-
-void Grid::resize(int width, int height)
-{
-    qDebug() << "resize is called with " << width << ":" << height;
-
-    bool widthIsAllowed = (width >= 0 && width <= MAX_WIDTH);
-    bool heightIsAllowed = (height >= 0 && height <= MAX_HEIGHT);
-
-    if (widthIsAllowed && heightIsAllowed)
-    {
-        m_size.setWidth(width);
-        m_size.setHeight(height);
-        qDebug() << "In Grid::resize. " << m_size;
-
-        generateNodes();
-    }
-}
-
-const Node& Grid::nodeAt(const QPoint &position)
-{
-    int row    = position.y();
-    int column = position.x();
-
-    // Since {m_nodes} is a vector of vectors,
-    // y value of position represents row,
-    // x value of position represents column.
-    return m_nodes.at(row).at(column);
-}
-
-QVector<Node> Grid::nodes() const
-{
-    QVector<Node> result;
-
-    foreach (QVector<Node> column, m_nodes)
-    {
-        foreach (Node node, column)
-            result.push_back(node);
-    }
-
-    return result;
-}
-
-QVector<Node> Grid::shortestPath(const Node &from, const Node &to) const
-{
-    qDebug() << QString ("Shortest path. Weights (%1 nodes): ").arg(m_weights.size());
-    for (int i = 0; i < m_weights.size(); ++i)
-        qDebug() << "Shortest path. " << m_weights.keys().at(i).toString() << " : " << m_weights.values().at(i) << "\n";
-
-    qDebug() << "Shortest path. Before";
-
-    Graph graph_copy = graph();
-
-    qDebug() << "Shortest path. There";
-          graph_copy.setWeights(m_weights);
-
-    qDebug() << "Shortest path. Here";
-    qDebug() << "Shortest path. Node {3,3} has weight of " << graph_copy.weightOf(Node(3, 3));
-
-    QVector<Node> shortestPath = graph_copy.shortestPath(from, to);
-
-    qDebug() << QString("Shortest path found. There are %1 nodes there.").arg(shortestPath.size());
-    qDebug() << QString("Shortest path is:");
-    for (int i = 0; i < shortestPath.size(); ++i)
-    {
-        int index = i;
-        Node node = shortestPath.at(i);
-        qDebug() << QString("Shortest path. Step %1: %2.").arg(index).arg(node.toString());
-    }
-
-
-    return shortestPath;
-}
-
-QVector<Node> Grid::row(const int &i) const
-{
-    QVector<Node> result;
-
-    foreach (QVector<Node> col_nodes, m_nodes)
-        result.push_back(col_nodes[i]);
-
-    return result;
-}
-
-QVector<Node> Grid::col(const int &i) const
-{
-    return m_nodes[i];
-}
-
-// ==================== SPT
-
-// Mark the node as filled of unfilled (for one node, one point, whole row or column).
-// Check if the node is filled or unfilled.
-void Grid::fill(const Node &node)
-{
-    m_isFilled[node] = true;
-}
-
-void Grid::fill(const QPoint &pos)
-{
-    fill(Node(pos.x(),pos.y()));
-}
-
-void Grid::unfill(const Node &node)
-{
-    m_isFilled[node] = false;
-}
-
-void Grid::unfill(const QPoint &pos)
-{
-    unfill(Node(pos.x(),pos.y()));
-}
-
-bool Grid::isFilled(const Node &node) const
-{
-    return m_isFilled[node];
-}
-
-bool Grid::isFilled(const QPoint &pos) const
-{
-    return isFilled(Node(pos.x(),pos.y()));
-}
-
-void Grid::fillRow(const int &i)
-{
-    foreach (Node node, row(i))
-        fill(node);
-}
-
-void Grid::fillColumn(const int &i)
-{
-    foreach (Node node, col(i))
-        fill(node);
-}
-
-void Grid::fillVector(const QVector<QVector<int> > &vec)
-{
-    for (int y = 0; y < m_nodes[0].size(); ++y) // H
-        for (int x = 0; x < m_nodes.size(); ++x) // W
-            if (vec[y][x] == 1)
-                fill(QPoint(x,y));
-}
-
-int Grid::weightFor(const Node &node)
-{
-    return m_weights[node];
-}
-
-int Grid::weightFor(const QPoint &position)
-{
-    return m_weights[Node(position.x(), position.y())];
-}
-
-void Grid::setWeightFor(const Node &node, int value)
-{
-    m_weights[node] = value;
-}
-
-void Grid::setWeightFor(const QPoint &position, int value)
-{
-    m_weights[Node(position.x(), position.y())] = value;
-}
-
-// Returns vector of all neighbouring unfilled nodes for current {node}.
-// This method describes all directions (!), that are tracable from the current node.
-QVector<Node> Grid::unfilledNeighbourNodesFor(const Node &node) const
-{
-    QVector<Node> result;
-
-    int rows_count = m_nodes[0].size();
-    int cols_count = m_nodes.size();
-
-    // up
-    if (node.y() > 0)
-    {
-        Node top_node (node.x(),node.y() - 1);
-        if (!isFilled(top_node))
-            result.push_back(top_node);
-    }
-
-    // down
-    if (node.y() < rows_count - 1)
-    {
-        Node bottom_node (node.x(), node.y() + 1);
-        if (!isFilled(bottom_node))
-            result.push_back(bottom_node);
-    }
-
-    // left
-    if (node.x() > 0)
-    {
-        Node left_node (node.x() - 1, node.y());
-        if (!isFilled(left_node))
-            result.push_back(left_node);
-    }
-
-    // right
-    if (node.x() < cols_count - 1)
-    {
-        Node right_node (node.x() + 1, node.y());
-        if (!isFilled(right_node))
-            result.push_back(right_node);
-    }
-
-    /*
-    // Diagonal movement:
-    // вверх-влево
-    if (node.y() > 0 && node.x() > 0)
-    {
-        Node topleft_node (node.x() - 1, node.y() - 1);
-        if (!isFilled(topleft_node))
-            result.push_back(topleft_node);
-    }
-
-    // вверх-вправо
-    if (node.y() > 0 && node.x() < cols_count - 1)
-    {
-        Node topright_node (node.x() + 1, node.y() - 1);
-        if (!isFilled(topright_node))
-            result.push_back(topright_node);
-    }
-
-    // вниз-влево
-    if (node.y() < rows_count - 1 && node.x() > 0)
-    {
-        Node bottomleft_node (node.x() - 1, node.y() + 1);
-        if (!isFilled(bottomleft_node))
-            result.push_back(bottomleft_node);
-    }
-
-    // вниз-вправо
-    if (node.y() < rows_count - 1 && node.x() < cols_count - 1)
-    {
-        Node bottomright_node (node.x() + 1, node.y() + 1);
-        if (!isFilled(bottomright_node))
-            result.push_back(bottomright_node);
-    }
-    */
-
-    return result;
-}
+#include <QTextStream>
+#include <QFile>
+#include <QSize>
+#include <QPoint>
+
+#include "grid.h"
+
+// The highest weight, that fits the byte of the cell.
+static const int MAX_WEIGHT = 255;
+
+// Checks the cell {dx, dy} of the square around the cell (see ChunkStore::filledAround).
+static inline bool isFilledAround(int around, int dx, int dy)
+{
+    return (around >> ((dy + 1) * 3 + dx + 1)) & 1;
+}
+
+Grid::Grid(const QSize& size)
+{
+    qDebug() << "in Grid constructor";
+
+    m_size = size;    
+
+    initialize();
+    generateNodes();
+}
+
+Grid::~Grid()
+{
+
+}
+
+Graph Grid::makeGraph() const
+{
+    // 1. Add all the existing nodes into the resulting graph.
+    // 2. Add all the existing edges between unfilled nodes into graph. For this we need look through all the nodes:
+    //    - Do nothing, if it is already filled.
+    //    - Check all the neighbour node for each of the nodes in the graph and add connecting edges for them.
+
+    Graph result;
+
+    // add nodes
+    foreach (Node node, nodes())
+        result.addNode(node);
+
+    // add edges
+    foreach (Node node, result.nodes())
+    {
+        if (isFilled(node))
+            continue;
+
+        QVector<Node> neighbour_nodes = unfilledNeighbourNodesFor(node);
+        foreach (Node neighbour, neighbour_nodes)
+        {
+            result.addEdge(node, neighbour, stepCost(node, neighbour));
+            result.addEdge(neighbour, node, stepCost(neighbour, node));
+        }
+    }
+
+    qDebug() << "Shortest path. Graph was generated: ";
+    qDebug() << "Shortest path. Nodes: " << result.nodes().size();
+    qDebug() << "Shortest path. Edges: " << result.edges().size();
+
+    return result;
+}
+
+// Builds the compact form of the graph: node index is the cell index, filled cells have no edges.
+// Edges are the same as in {makeGraph}, but every node gets its outgoing edges right away.
+CompactGraph Grid::makeCompactGraph() const
+{
+    CompactGraph result;
+    result.reserve(width() * height(), width() * height() * (m_diagonalMovement ? 8 : 4));
+
+    for (int index = 0; index < width() * height(); ++index)
+    {
+        Node node = nodeAt(index);
+        result.appendNode(node);
+
+        if (isFilled(node))
+            continue;
+
+        foreach (Node neighbour, unfilledNeighbourNodesFor(node))
+            result.appendEdge(indexOf(neighbour), stepCost(node, neighbour));
+    }
+
+    qDebug() << QString("Shortest path. Compact graph was generated: %1 nodes, %2 edges.").arg(result.nodeCount()).arg(result.edgeCount());
+
+    return result;
+}
+
+// Graph is built at the first call, so that the maps, that are searched only on the grid, don't keep it.
+const CompactGraph &Grid::compactGraph() const
+{
+    if (m_graph.nodeCount() != width() * height())
+        buildGraph();
+
+    return m_graph;
+}
+
+void Grid::initialize()
+{
+    m_cells.reset(0, 0);
+}
+
+// Nodes are not stored: the cell is its index in the chunk store, and the node is made from the index, when it is asked for.
+void Grid::generateNodes()
+{
+    qDebug() << "Grid::generateNodes";
+
+    int count = m_size.width() * m_size.height();
+
+    m_components.reset(m_size.width(), m_size.height());
+    m_graph = CompactGraph();
+
+    // Weights of the cells, that stay in the grid, are kept.
+    m_cells.resize(m_size.width(), m_size.height());
+    m_cells.unfillAll();
+
+    // All the cells are unfilled. It is one change of the whole grid, not the change of every cell.
+    m_unfilledOfWeight.fill(0, MAX_WEIGHT + 1);
+    for (int index = 0; index < count; ++index)
+        ++m_unfilledOfWeight[m_cells.weightOf(index)];
+
+    m_minimumWeight = 0;
+    countUnfilled(0, 0);
+
+    recordReset();
+
+    qDebug() << "Cells count: " << count;
+}
+
+Graph Grid::graph() const
+{
+    return makeGraph();
+}
+
+void Grid::resize(int width, int height)
+{
+    qDebug() << "resize is called with " << width << ":" << height;
+
+    bool widthIsAllowed = (width >= 0 && width <= MAX_WIDTH);
+    bool heightIsAllowed = (height >= 0 && height <= MAX_HEIGHT);
+
+    if (widthIsAllowed && heightIsAllowed)
+    {
+        m_size.setWidth(width);
+        m_size.setHeight(height);
+        qDebug() << "In Grid::resize. " << m_size;
+
+        generateNodes();
+    }
+}
+
+int Grid::width() const
+{
+    return m_size.width();
+}
+
+int Grid::height() const
+{
+    return m_size.height();
+}
+
+bool Grid::contains(const Node &node) const
+{
+    return node.x() >= 0 && node.x() < width() && node.y() >= 0 && node.y() < height();
+}
+
+Node Grid::nodeAt(const QPoint &position) const
+{
+    return Node(position.x(), position.y());
+}
+
+int Grid::indexOf(const Node &node) const
+{
+    return node.y() * width() + node.x();
+}
+
+Node Grid::nodeAt(int index) const
+{
+    return Node(index % width(), index / width());
+}
+
+// Nodes go column by column.
+QVector<Node> Grid::nodes() const
+{
+    QVector<Node> result;
+    result.reserve(width() * height());
+
+    for (int x = 0; x < width(); ++x)
+        result += col(x);
+
+    return result;
+}
+
+QVector<Node> Grid::shortestPath(const Node &from, const Node &to) const
+{
+    // The graph is kept up to date with the cells, so it is searched right away.
+    QVector<Node> shortestPath = compactGraph().shortestPath(from, to);
+
+    qDebug() << QString("Shortest path found. There are %1 nodes there.").arg(shortestPath.size());
+    qDebug() << QString("Shortest path is:");
+    for (int i = 0; i < shortestPath.size(); ++i)
+    {
+        int index = i;
+        Node node = shortestPath.at(i);
+        qDebug() << QString("Shortest path. Step %1: %2.").arg(index).arg(node.toString());
+    }
+
+
+    return shortestPath;
+}
+
+QVector<Node> Grid::row(const int &i) const
+{
+    QVector<Node> result;
+
+    for (int x = 0; x < width(); ++x)
+        result.push_back(Node(x, i));
+
+    return result;
+}
+
+QVector<Node> Grid::col(const int &i) const
+{
+    QVector<Node> result;
+
+    for (int y = 0; y < height(); ++y)
+        result.push_back(Node(i, y));
+
+    return result;
+}
+
+// ==================== SPT
+
+// Mark the node as filled of unfilled (for one node, one point, whole row or column).
+// Check if the node is filled or unfilled.
+void Grid::fill(const Node &node)
+{
+    if (contains(node) && !isFilled(node))
+    {
+        countUnfilled(weightFor(node), -1);
+        m_cells.setFilled(indexOf(node), true);
+        m_components.change(indexOf(node));
+    }
+
+    recordChange(node);
+    updateGraphAround(node);
+}
+
+void Grid::fill(const QPoint &pos)
+{
+    fill(Node(pos.x(),pos.y()));
+}
+
+void Grid::unfill(const Node &node)
+{
+    if (contains(node) && isFilled(node))
+    {
+        m_cells.setFilled(indexOf(node), false);
+        countUnfilled(weightFor(node), 1);
+        m_components.change(indexOf(node));
+    }
+
+    recordChange(node);
+    updateGraphAround(node);
+}
+
+void Grid::unfill(const QPoint &pos)
+{
+    unfill(Node(pos.x(),pos.y()));
+}
+
+// Cells outside the grid are not filled: they are just not there.
+bool Grid::isFilled(const Node &node) const
+{
+    return contains(node) && m_cells.isFilled(indexOf(node));
+}
+
+bool Grid::isFilled(const QPoint &pos) const
+{
+    return isFilled(Node(pos.x(),pos.y()));
+}
+
+bool Grid::isFilled(int index) const
+{
+    return m_cells.isFilled(index);
+}
+
+int Grid::componentOf(const Node &node) const
+{
+    return contains(node) ? m_components.labelOf(m_cells, indexOf(node)) : -1;
+}
+
+bool Grid::areConnected(const Node &from, const Node &to) const
+{
+    return contains(from) && contains(to) && m_components.areConnected(m_cells, indexOf(from), indexOf(to));
+}
+
+int Grid::componentCount() const
+{
+    return m_components.componentCount(m_cells);
+}
+
+void Grid::fillRow(const int &i)
+{
+    foreach (Node node, row(i))
+        fill(node);
+}
+
+void Grid::fillColumn(const int &i)
+{
+    foreach (Node node, col(i))
+        fill(node);
+}
+
+void Grid::fillVector(const QVector<QVector<int> > &vec)
+{
+    for (int y = 0; y < height(); ++y) // H
+        for (int x = 0; x < width(); ++x) // W
+            if (vec[y][x] == 1)
+                fill(QPoint(x,y));
+}
+
+int Grid::weightFor(const Node &node) const
+{
+    return contains(node) ? m_cells.weightOf(indexOf(node)) : 0;
+}
+
+int Grid::weightFor(const QPoint &position) const
+{
+    return weightFor(Node(position.x(), position.y()));
+}
+
+int Grid::weightFor(int index) const
+{
+    return m_cells.weightOf(index);
+}
+
+void Grid::setWeightFor(const Node &node, int value)
+{
+    value = qBound(0, value, MAX_WEIGHT);
+
+    if (contains(node) && !isFilled(node))
+    {
+        countUnfilled(weightFor(node), -1);
+        countUnfilled(value, 1);
+    }
+
+    if (contains(node))
+        m_cells.setWeight(indexOf(node), value);
+
+    m_maximumWeight = qMax(m_maximumWeight, value);
+    recordChange(node);
+    updateGraphAround(node);
+}
+
+void Grid::setWeightFor(const QPoint &position, int value)
+{
+    setWeightFor(Node(position.x(), position.y()), value);
+}
+
+uint Grid::version() const
+{
+    return m_version;
+}
+
+// Writes the cells, that were changed after the {version}, to {cells} (a cell may be there several times).
+// Returns false, if the log doesn't reach that far back or the whole grid has changed (size or movement rules).
+bool Grid::changedCellsSince(uint version, QVector<int> &cells) const
+{
+    cells.clear();
+
+    if (version < m_changesStart || version > m_version)
+        return false;
+
+    for (int i = int(version - m_changesStart); i < m_changes.size(); ++i)
+        if (m_changes[i] != -1)
+            cells.push_back(m_changes[i]);
+
+    return true;
+}
+
+// Every change of the cell gives the new version of the grid. Old records are dropped, when there are too many of them.
+void Grid::recordChange(const Node &node)
+{
+    if (m_changes.size() == MAX_CHANGES)
+    {
+        m_changes.remove(0, MAX_CHANGES / 2);
+        m_changesStart += MAX_CHANGES / 2;
+    }
+
+    m_changes.push_back(contains(node) ? indexOf(node) : -1);
+    ++m_version;
+}
+
+void Grid::recordReset()
+{
+    m_changes.clear();
+    m_changesStart = ++m_version;
+}
+
+// Every node gets the slots for all the steps, it may ever have, so that the edges are always replaced in place.
+void Grid::buildGraph() const
+{
+    m_graph = CompactGraph();
+    m_graph.reserve(width() * height(), width() * height() * MAX_NEIGHBOURS);
+
+    for (int index = 0; index < width() * height(); ++index)
+    {
+        m_graph.appendNode(nodeAt(index));
+        m_graph.appendFreeSlots(MAX_NEIGHBOURS);
+    }
+
+    for (int index = 0; index < width() * height(); ++index)
+        updateEdgesOf(index);
+}
+
+// The cell changes the steps to it and from it, and (with diagonal movement) the diagonal steps around its corners.
+// All of them start in the 3x3 square around the cell, so only those nodes get their edges again.
+void Grid::updateGraphAround(const Node &node)
+{
+    // Graph, that isn't built yet, will get all the edges at once.
+    if (!contains(node) || m_graph.nodeCount() != width() * height())
+        return;
+
+    for (int y = qMax(node.y() - 1, 0); y <= qMin(node.y() + 1, height() - 1); ++y)
+        for (int x = qMax(node.x() - 1, 0); x <= qMin(node.x() + 1, width() - 1); ++x)
+            updateEdgesOf(y * width() + x);
+}
+
+void Grid::updateEdgesOf(int index) const
+{
+    int targets[MAX_NEIGHBOURS];
+    int weights[MAX_NEIGHBOURS];
+    int count = 0;
+
+    if (!isFilled(index))
+    {
+        count = unfilledNeighboursOf(index, targets);
+        for (int i = 0; i < count; ++i)
+            weights[i] = stepCost(index, targets[i]);
+    }
+
+    m_graph.setEdges(index, targets, weights, count);
+}
+
+int Grid::minimumWeight() const
+{
+    return m_minimumWeight;
+}
+
+// Adds {change} to the count of unfilled cells with the {weight} and moves the minimum to the lowest weight, that is counted.
+// Without unfilled cells the minimum stays at the highest weight.
+void Grid::countUnfilled(int weight, int change)
+{
+    m_unfilledOfWeight[weight] += change;
+    m_minimumWeight = qMin(m_minimumWeight, weight);
+
+    while (m_minimumWeight < MAX_WEIGHT && m_unfilledOfWeight[m_minimumWeight] == 0)
+        ++m_minimumWeight;
+}
+
+int Grid::maximumWeight() const
+{
+    return m_maximumWeight;
+}
+
+int Grid::maximumStepCost() const
+{
+    return m_diagonalMovement ? diagonalCost(m_maximumWeight) : m_maximumWeight;
+}
+
+bool Grid::setPageFile(const QString &filename)
+{
+    return m_cells.setPageFile(filename);
+}
+
+void Grid::setChunkBudget(int chunks)
+{
+    m_cells.setBudget(chunks);
+}
+
+int Grid::residentChunkCount() const
+{
+    return m_cells.residentCount();
+}
+
+void Grid::pinChunks() const
+{
+    m_cells.pin();
+}
+
+void Grid::unpinChunks() const
+{
+    m_cells.unpin();
+}
+
+bool Grid::diagonalMovement() const
+{
+    return m_diagonalMovement;
+}
+
+void Grid::setDiagonalMovement(bool allowed)
+{
+    if (m_diagonalMovement == allowed)
+        return;
+
+    m_diagonalMovement = allowed;
+    recordReset();
+
+    for (int index = 0; index < m_graph.nodeCount(); ++index)
+        updateEdgesOf(index);
+}
+
+// Returns the cost of the single step between two neighbouring nodes.
+int Grid::stepCost(const Node &from, const Node &to) const
+{
+    int weight = weightFor(to);
+
+    if (from.x() != to.x() && from.y() != to.y())
+        return diagonalCost(weight);
+
+    return weight;
+}
+
+int Grid::stepCost(int from, int to) const
+{
+    int x = to % width();
+    int y = to / width();
+    int weight = m_cells.weightOf(x, y);
+
+    if (from % width() != x && from / width() != y)
+        return diagonalCost(weight);
+
+    return weight;
+}
+
+int Grid::diagonalCost(int weight)
+{
+    return weight * 14 / 10;
+}
+
+// Returns vector of all neighbouring unfilled nodes for current {node}.
+// This method describes all directions (!), that are tracable from the current node.
+QVector<Node> Grid::unfilledNeighbourNodesFor(const Node &node) const
+{
+    QVector<Node> result;
+
+    if (!contains(node))
+        return result;
+
+    int neighbours[MAX_NEIGHBOURS];
+    int count = unfilledNeighboursOf(indexOf(node), neighbours);
+
+    for (int i = 0; i < count; ++i)
+        result.push_back(nodeAt(neighbours[i]));
+
+    return result;
+}
+
+// Writes indices of all the unfilled cells, that are reachable in one step from the cell {index}, to {result}.
+// Returns the count of them. Nothing is allocated here, so the search algorithms call it for every opened cell.
+int Grid::unfilledNeighboursOf(int index, int *result) const
+{
+    int count = 0;
+
+    int x = index % width();
+    int y = index / width();
+    int around = m_cells.filledAround(x, y);
+
+    bool up    = y > 0            && !isFilledAround(around, 0, -1);
+    bool down  = y < height() - 1 && !isFilledAround(around, 0, 1);
+    bool left  = x > 0            && !isFilledAround(around, -1, 0);
+    bool right = x < width() - 1  && !isFilledAround(around, 1, 0);
+
+    if (up)
+        result[count++] = index - width();
+
+    if (down)
+        result[count++] = index + width();
+
+    if (left)
+        result[count++] = index - 1;
+
+    if (right)
+        result[count++] = index + 1;
+
+    // Diagonal movement:
+    // it is allowed only if both cells, that are adjacent to the diagonal, are unfilled.
+    if (!m_diagonalMovement)
+        return count;
+
+    // вверх-влево
+    if (up && left && !isFilledAround(around, -1, -1))
+        result[count++] = index - width() - 1;
+
+    // вверх-вправо
+    if (up && right && !isFilledAround(around, 1, -1))
+        result[count++] = index - width() + 1;
+
+    // вниз-влево
+    if (down && left && !isFilledAround(around, -1, 1))
+        result[count++] = index + width() - 1;
+
+    // вниз-вправо
+    if (down && right && !isFilledAround(around, 1, 1))
+        result[count++] = index + width() + 1;
+
+    return count;
+}
@@ -1,67 +1,146 @@
-#ifndef GRID_H
-#define GRID_H
-
-#include "Graph/graph.h"
-#include <QtXml/QtXml>
-
-class QSize;
-class QPoint;
-
-// Grid class represents 2-dimensional grid with logic cells of 1x1 size.
-// This grid will be used then to find the shortest path between two cells.
-// Every cell has 2-dimensional coordinates, tracebility status and weight.
-class Grid
-{
-public:
-    Grid(const QSize& size = QSize(0,0));
-    ~Grid();
-
-    Graph makeGraph() const;
-    Graph graph() const;
-
-    void resize (int width, int height);
-
-
-    QVector<Node> nodes() const;
-    const Node&   nodeAt (const QPoint& position);
-    QVector<Node> shortestPath (const Node& from, const Node& to) const;
-
-    QVector<Node> row (const int& index) const;
-    QVector<Node> col (const int& index) const;
-
-    // Making nodes tracable or untracable (by node, by position, by row, by column)
-    void fill     (const Node& node);
-    void unfill   (const Node& node);
-    bool isFilled (const Node& node) const;
-
-    void fill     (const QPoint& position);
-    void unfill   (const QPoint& position);
-    bool isFilled (const QPoint& position) const;
-
-    void fillRow    (const int& rowIndex);
-    void fillColumn (const int& colIndex);
-    void fillVector (const QVector<QVector<int> >& vec);
-
-    // Operating on weights
-    int weightFor (const Node& node);
-    int weightFor (const QPoint& position);    
-    void setWeightFor (const Node& node, int value);
-    void setWeightFor (const QPoint& position, int value);       
-
-private:
-    void initialize();
-    void generateNodes();
-
-    QVector<Node> unfilledNeighbourNodesFor (const Node& node) const;
-
-    static constexpr int MAX_WIDTH = 50;
-    static constexpr int MAX_HEIGHT = 50;
-
-    Graph                   m_graph;
-    QSize                   m_size;
-    QVector<QVector<Node>>  m_nodes;
-    QMap<Node, bool>        m_isFilled;
-    QMap<Node, int >        m_weights;
-};
-
-#endif // GRID_H
+#ifndef GRID_H
+#define GRID_H
+
+#include "Graph/graph.h"
+#include "Graph/compactgraph.h"
+#include "connectedcomponents.h"
+#include "chunkstore.h"
+#include <QtXml/QtXml>
+
+class QSize;
+class QPoint;
+
+// Grid class represents 2-dimensional grid with logic cells of 1x1 size.
+// This grid will be used then to find the shortest path between two cells.
+// Every cell has 2-dimensional coordinates, tracebility status and weight.
+class Grid
+{
+public:
+    Grid(const QSize& size = QSize(0,0));
+    ~Grid();
+
+    Graph makeGraph() const;
+    Graph graph() const;
+    CompactGraph makeCompactGraph() const;
+
+    // Graph of the grid, that is kept up to date: changed cell rewrites only the edges around it.
+    // Node index is the cell index, every node has slots for MAX_NEIGHBOURS edges.
+    // It is built at the first call and takes about a hundred bytes per cell, so the big maps are searched on the grid itself.
+    const CompactGraph& compactGraph() const;
+
+    void resize (int width, int height);
+    int  width  () const;
+    int  height () const;
+    bool contains (const Node& node) const;
+
+    QVector<Node> nodes() const;
+    Node          nodeAt (const QPoint& position) const;
+    QVector<Node> shortestPath (const Node& from, const Node& to) const;
+
+    // Cells are indexed row by row (y * width + x). Search algorithms use these indices to address their per-cell data.
+    int  indexOf (const Node& node) const;
+    Node nodeAt  (int index) const;
+
+    QVector<Node> row (const int& index) const;
+    QVector<Node> col (const int& index) const;
+
+    // Making nodes tracable or untracable (by node, by position, by row, by column)
+    void fill     (const Node& node);
+    void unfill   (const Node& node);
+    bool isFilled (const Node& node) const;
+
+    void fill     (const QPoint& position);
+    void unfill   (const QPoint& position);
+    bool isFilled (const QPoint& position) const;
+
+    bool isFilled (int index) const;
+
+    // Cells, that have a path between them, belong to the same component. Filled cells have label -1.
+    // The first query after the change of the cells computes the labels of the changed chunks again (see ConnectedComponents).
+    int  componentOf  (const Node& node) const;
+    bool areConnected (const Node& from, const Node& to) const;
+    int  componentCount () const;
+
+    void fillRow    (const int& rowIndex);
+    void fillColumn (const int& colIndex);
+    void fillVector (const QVector<QVector<int> >& vec);
+
+    // Operating on weights. Weight takes one byte per cell, so it is clamped to 0..255.
+    int weightFor (const Node& node) const;
+    int weightFor (const QPoint& position) const;
+    int weightFor (int index) const;
+    void setWeightFor (const Node& node, int value);
+    void setWeightFor (const QPoint& position, int value);
+
+    // Version of the grid grows with every change of the cells (filling, unfilling, weights, size and movement rules).
+    // Cached search results remember the version, they were computed for, so they know, when they become outdated.
+    // The latest changes are logged, so the caches, that are built per region, may update only the changed cells.
+    uint version () const;
+    bool changedCellsSince (uint version, QVector<int>& cells) const;
+
+    // The lowest weight of the unfilled cells. Heuristics are scaled by it, so that they never overestimate the real cost of the path.
+    // Unfilled cells are counted by weight, so it follows every fill, unfill and change of the weight.
+    int  minimumWeight () const;
+
+    // The highest weight, that was ever set for the cell of this grid, and the cost of the most expensive single step.
+    int  maximumWeight () const;
+    int  maximumStepCost () const;
+
+    // Cells are kept in chunks (see ChunkStore): only the written parts of the map take memory.
+    // With the page file, chunks over the budget (count of chunks in memory, 0 means no limit) are paged out,
+    // so the search takes into memory only the chunks, that its frontier reaches.
+    bool setPageFile (const QString& filename);
+    void setChunkBudget (int chunks);
+    int  residentChunkCount () const;
+
+    // Searches, that read the grid from several threads, pin the chunks: they are paged in, but not evicted until unpinned.
+    void pinChunks   () const;
+    void unpinChunks () const;
+
+    // Movement rules. By default units move only up, down, left and right.
+    // Diagonal movement is allowed only if it doesn't cut the corner of filled cell.
+    // Moving to the cell costs its weight. Diagonal step costs 1.4 of the weight (rounded down to whole action points).
+    bool diagonalMovement () const;
+    void setDiagonalMovement (bool allowed);
+    int  stepCost (const Node& from, const Node& to) const;
+    int  stepCost (int from, int to) const;
+    static int diagonalCost (int weight);
+
+    // Returns all neighbouring unfilled nodes, that are reachable in one step from the {node}.
+    // Index version writes up to MAX_NEIGHBOURS cell indices to {result} and returns their count.
+    static constexpr int MAX_NEIGHBOURS = 8;
+    QVector<Node> unfilledNeighbourNodesFor (const Node& node) const;
+    int unfilledNeighboursOf (int index, int* result) const;
+
+private:
+    void initialize();
+    void generateNodes();
+    void recordChange (const Node& node);
+    void recordReset  ();
+    void countUnfilled (int weight, int change);
+
+    void buildGraph        () const;
+    void updateGraphAround (const Node& node);
+    void updateEdgesOf     (int index) const;
+
+    // Side of the grid is limited, so that the edge slots of the whole graph (MAX_NEIGHBOURS per cell) are counted by int.
+    static constexpr int MAX_WIDTH = 8192;
+    static constexpr int MAX_HEIGHT = 8192;
+    static constexpr int MAX_CHANGES = 4096;
+
+    mutable CompactGraph    m_graph;
+    QSize                   m_size;
+
+    // Filled flags take one bit, weights take one byte.
+    ChunkStore              m_cells;
+    QVector<int>            m_unfilledOfWeight;
+    int                     m_minimumWeight = 0;
+    int                     m_maximumWeight = 0;
+    bool                    m_diagonalMovement = false;
+    uint                    m_version = 0;
+    uint                    m_changesStart = 0;
+    QVector<int>            m_changes;
+    ConnectedComponents     m_components;
+};
+
+#endif // GRID_H
@@ -0,0 +1,72 @@
+#include "heuristic.h"
+#include "grid.h"
+#include "landmarks.h"
+
+Heuristic::Heuristic(const Type& type, int minimumWeight, const Landmarks* landmarks, bool diagonalMovement)
+{
+    m_type = type;
+    m_landmarks = landmarks;
+    m_diagonalMovement = diagonalMovement;
+
+    // The cheapest step on the grid, that the estimate is built from.
+    m_straightCost = qMax(minimumWeight, 0);
+    m_diagonalCost = Grid::diagonalCost(m_straightCost);
+}
+
+Heuristic::~Heuristic()
+{
+
+}
+
+const Heuristic::Type &Heuristic::type() const
+{
+    return m_type;
+}
+
+int Heuristic::minimumWeight() const
+{
+    return m_straightCost;
+}
+
+int Heuristic::estimate(const Node &from, const Node &to) const
+{
+    int dx = qAbs(from.x() - to.x());
+    int dy = qAbs(from.y() - to.y());
+
+    switch (m_type)
+    {
+        case Type::ZERO:
+        return 0;
+
+        case Type::MANHATTAN:
+        return m_straightCost * (dx + dy);
+
+        case Type::OCTILE:
+        // Go diagonally, while both coordinates differ, and straight for the rest of the way.
+        return m_diagonalCost * qMin(dx, dy) + m_straightCost * (qMax(dx, dy) - qMin(dx, dy));
+
+        case Type::LANDMARKS:
+        return m_landmarks ? qMax(distance(dx, dy), m_landmarks->estimate(from, to)) : distance(dx, dy);
+    }
+
+    return 0;
+}
+
+// The distance, that suits the movement: without diagonal steps the path can't be shorter than MANHATTAN.
+int Heuristic::distance(int dx, int dy) const
+{
+    if (!m_diagonalMovement)
+        return m_straightCost * (dx + dy);
+
+    return m_diagonalCost * qMin(dx, dy) + m_straightCost * (qMax(dx, dy) - qMin(dx, dy));
+}
+
+// Distance based estimates change by the estimate of one diagonal step at most.
+// Landmark bounds are consistent: one step changes them by not more than the cost of the step back.
+int Heuristic::maximumStepChange(int maximumStepCost) const
+{
+    if (m_type == Type::LANDMARKS && m_landmarks)
+        return qMax(maximumStepCost, distance(1, 1));
+
+    return estimate(Node(0,0), Node(1,1));
+}
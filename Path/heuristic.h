@@ -0,0 +1,41 @@
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include "Graph/node.h"
+
+class Landmarks;
+
+// Heuristic estimates the cost of the path between two nodes of the grid. It is used by A* to look towards the goal.
+// To keep found path the shortest one, estimate must never be greater than the real cost (heuristic must be admissible).
+// That's why every estimate is scaled by the lowest weight, that the cell of the grid may have.
+// - ZERO      doesn't look at the goal at all (A* turns into plain Dijkstra search);
+// - MANHATTAN is the exact distance for the grids with 4-neighbour movement and equal weights;
+// - OCTILE    is the exact distance for the grids with 8-neighbour movement and equal weights;
+// - LANDMARKS takes the best of the distance, that suits the movement (OCTILE or MANHATTAN), and landmark bounds
+//   (see Landmarks). Without landmarks it is that distance.
+class Heuristic
+{
+public:
+    enum class Type {ZERO, MANHATTAN, OCTILE, LANDMARKS};
+    Heuristic(const Type& type = Type::MANHATTAN, int minimumWeight = 1, const Landmarks* landmarks = nullptr, bool diagonalMovement = true);
+    ~Heuristic();
+
+    const Type& type() const;
+    int minimumWeight() const;
+
+    int estimate (const Node& from, const Node& to) const;
+
+    // The most, that the estimate may grow by, when the search makes one step on the grid, where steps cost up to {maximumStepCost}.
+    int maximumStepChange (int maximumStepCost) const;
+
+private:
+    int distance (int dx, int dy) const;
+
+    Type m_type;
+    bool m_diagonalMovement;
+    int  m_straightCost;
+    int  m_diagonalCost;
+    const Landmarks* m_landmarks;
+};
+
+#endif // HEURISTIC_H
@@ -0,0 +1,421 @@
+#include "hierarchicalsearch.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+HierarchicalSearch::HierarchicalSearch(int clusterSize)
+{
+    m_clusterSize = qMax(2, clusterSize);
+}
+
+HierarchicalSearch::~HierarchicalSearch()
+{
+
+}
+
+int HierarchicalSearch::clusterSize() const
+{
+    return m_clusterSize;
+}
+
+// Abstract graph is built again from scratch on the next query.
+void HierarchicalSearch::setClusterSize(int size)
+{
+    m_clusterSize = qMax(2, size);
+    m_width = -1;
+}
+
+QVector<Node> HierarchicalSearch::shortestPath(const Grid &grid, const Node &from, const Node &to, const Heuristic &heuristic)
+{
+    m_pathCost = -1;
+    m_expandedCount = 0;
+
+    if (!grid.contains(from) || !grid.contains(to) || grid.isFilled(from) || grid.isFilled(to))
+    {
+        qDebug() << "Shortest path. HPA*: start or goal node can't be traced.";
+        return QVector<Node>();
+    }
+
+    // There is no path to the other island, so there is nothing to search.
+    if (!grid.areConnected(from, to))
+        return QVector<Node>();
+
+    update(grid);
+
+    int start = grid.indexOf(from);
+    int goal  = grid.indexOf(to);
+    int startCluster = clusterOf(grid, start);
+    int goalCluster  = clusterOf(grid, goal);
+
+    // 1. Connect the start to the entrances of its cluster (and to the goal, if it is in the same cluster).
+    m_startEdges.clear();
+    searchCluster(grid, startCluster, start, -1, false);
+    foreach (int entrance, m_clusters[startCluster].entrances)
+        if (m_local.isReached(entrance))
+            m_startEdges.insert(entrance, m_local.cost(entrance));
+
+    if (startCluster == goalCluster && m_local.isReached(goal))
+        m_startEdges.insert(goal, m_local.cost(goal));
+
+    // 2. Connect the entrances of the goal's cluster to the goal.
+    m_goalEdges.clear();
+    searchCluster(grid, goalCluster, goal, -1, true);
+    foreach (int entrance, m_clusters[goalCluster].entrances)
+        if (m_local.isReached(entrance))
+            m_goalEdges.insert(entrance, m_local.cost(entrance));
+
+    // 3. A* search over the abstract graph: the start, the goal and all the entrances.
+    m_space.prepare(grid.width() * grid.height());
+    PriorityQueue& open = m_space.open();
+    m_space.reach(start, 0, -1);
+    open.push(start, qint64(heuristic.estimate(from, to)) << 32);
+
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        ++m_expandedCount;
+
+        if (current == goal)
+            break;
+
+        if (current == start)
+        {
+            foreach (int next, m_startEdges.keys())
+                addEdge(heuristic, to, current, next, m_startEdges.value(next));
+        }
+
+        int index = m_entranceIndex.value(current, -1);
+        if (index == -1)
+            continue;
+
+        const Cluster& cluster = m_clusters[clusterOf(grid, current)];
+        int count = cluster.entrances.size();
+
+        for (int j = 0; j < count; ++j)
+        {
+            int cost = cluster.costs[index * count + j];
+            if (j != index && cost != -1)
+                addEdge(heuristic, to, current, cluster.entrances[j], cost);
+        }
+
+        foreach (const auto& link, cluster.links)
+            if (link.first == index)
+                addEdge(heuristic, to, current, link.second, grid.stepCost(current, link.second));
+
+        if (m_goalEdges.contains(current))
+            addEdge(heuristic, to, current, goal, m_goalEdges.value(current));
+    }
+
+    if (!m_space.isReached(goal))
+    {
+        qDebug() << QString("Shortest path. HPA*: goal can't be reached. Expanded nodes: %1.").arg(m_expandedCount);
+        return QVector<Node>();
+    }
+
+    // 4. Turn the abstract path into the path on the grid.
+    QVector<int> corridor;
+    for (int cell = goal; cell != -1; cell = m_space.parent(cell))
+        corridor.push_back(cell);
+
+    std::reverse(corridor.begin(), corridor.end());
+
+    m_pathCost = m_space.cost(goal);
+    qDebug() << QString("Shortest path. HPA*: goal reached. Cost: %1. Expanded nodes: %2. Abstract path: %3 nodes.").arg(m_pathCost).arg(m_expandedCount).arg(corridor.size());
+
+    return refine(grid, corridor);
+}
+
+int HierarchicalSearch::pathCost() const
+{
+    return m_pathCost;
+}
+
+int HierarchicalSearch::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+int HierarchicalSearch::rebuiltClusters() const
+{
+    return m_rebuiltClusters;
+}
+
+// Brings the abstract graph up to date with the grid. Only the clusters with changed cells are rebuilt,
+// unless the whole grid has changed (or the log of changes doesn't go back far enough).
+void HierarchicalSearch::update(const Grid &grid)
+{
+    QVector<int> changed;
+
+    bool sameGrid = grid.width() == m_width && grid.height() == m_height && grid.diagonalMovement() == m_diagonal;
+    if (!sameGrid || !grid.changedCellsSince(m_version, changed))
+    {
+        m_width    = grid.width();
+        m_height   = grid.height();
+        m_diagonal = grid.diagonalMovement();
+        m_columns  = (m_width  + m_clusterSize - 1) / m_clusterSize;
+        m_rows     = (m_height + m_clusterSize - 1) / m_clusterSize;
+
+        m_clusters = QVector<Cluster>(m_columns * m_rows);
+        m_entranceIndex.clear();
+    }
+    else
+    {
+        foreach (int cell, changed)
+            markCell(grid, cell);
+    }
+
+    m_version = grid.version();
+
+    m_rebuiltClusters = 0;
+    for (int cluster = 0; cluster < m_clusters.size(); ++cluster)
+    {
+        if (!m_clusters[cluster].outdated)
+            continue;
+
+        rebuild(grid, cluster);
+        ++m_rebuiltClusters;
+    }
+
+    if (m_rebuiltClusters > 0)
+        qDebug() << QString("Shortest path. HPA*: %1 of %2 clusters have been rebuilt.").arg(m_rebuiltClusters).arg(m_clusters.size());
+}
+
+// Finds the entrances of the cluster and the costs of the paths between them.
+void HierarchicalSearch::rebuild(const Grid &grid, int cluster)
+{
+    Cluster& data = m_clusters[cluster];
+
+    foreach (int entrance, data.entrances)
+        m_entranceIndex.remove(entrance);
+
+    data.entrances.clear();
+    data.links.clear();
+
+    int column = cluster % m_columns;
+    int row    = cluster / m_columns;
+
+    QVector<int> neighbours;
+    if (column > 0)
+        neighbours.push_back(cluster - 1);
+
+    if (column < m_columns - 1)
+        neighbours.push_back(cluster + 1);
+
+    if (row > 0)
+        neighbours.push_back(cluster - m_columns);
+
+    if (row < m_rows - 1)
+        neighbours.push_back(cluster + m_columns);
+
+    // Both clusters get the same transitions of their common border, so their links always match.
+    QVector<QPair<int, int>> pairs;
+    foreach (int neighbour, neighbours)
+    {
+        transitions(grid, qMin(cluster, neighbour), qMax(cluster, neighbour), pairs);
+
+        foreach (const auto& pair, pairs)
+        {
+            int inside  = cluster < neighbour ? pair.first  : pair.second;
+            int outside = cluster < neighbour ? pair.second : pair.first;
+
+            int index = m_entranceIndex.value(inside, -1);
+            if (index == -1)
+            {
+                index = data.entrances.size();
+                data.entrances.push_back(inside);
+                m_entranceIndex.insert(inside, index);
+            }
+
+            data.links.push_back(qMakePair(index, outside));
+        }
+    }
+
+    int count = data.entrances.size();
+    data.costs.fill(-1, count * count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        searchCluster(grid, cluster, data.entrances[i], -1, false);
+
+        for (int j = 0; j < count; ++j)
+            data.costs[i * count + j] = m_local.cost(data.entrances[j]);
+    }
+
+    data.outdated = false;
+}
+
+// Changed cell outdates its cluster. The cell on the border changes the entrances of the neighbouring cluster too.
+void HierarchicalSearch::markCell(const Grid &grid, int cell)
+{
+    int x = cell % grid.width();
+    int y = cell / grid.width();
+
+    m_clusters[clusterOf(grid, cell)].outdated = true;
+
+    if (x % m_clusterSize == 0 && x > 0)
+        m_clusters[clusterOf(grid, cell - 1)].outdated = true;
+
+    if (x % m_clusterSize == m_clusterSize - 1 && x < grid.width() - 1)
+        m_clusters[clusterOf(grid, cell + 1)].outdated = true;
+
+    if (y % m_clusterSize == 0 && y > 0)
+        m_clusters[clusterOf(grid, cell - grid.width())].outdated = true;
+
+    if (y % m_clusterSize == m_clusterSize - 1 && y < grid.height() - 1)
+        m_clusters[clusterOf(grid, cell + grid.width())].outdated = true;
+}
+
+int HierarchicalSearch::clusterOf(const Grid &grid, int cell) const
+{
+    int x = cell % grid.width();
+    int y = cell / grid.width();
+
+    return (y / m_clusterSize) * m_columns + x / m_clusterSize;
+}
+
+bool HierarchicalSearch::isInside(const Grid &grid, int cell, int cluster) const
+{
+    return clusterOf(grid, cell) == cluster;
+}
+
+// Writes the transitions of the border between {first} cluster and {second} one (it is either to the right or below).
+// Every run of unfilled cell pairs across the border is one entrance: short ones get one transition in the middle,
+// long ones get two transitions at their ends.
+void HierarchicalSearch::transitions(const Grid &grid, int first, int second, QVector<QPair<int, int>> &result) const
+{
+    result.clear();
+
+    bool vertical = (second == first + 1) && (second % m_columns != 0);
+
+    // Border runs along the {length} cells, starting at {origin} in the first cluster. {across} moves over the border, {along} moves along it.
+    int column = first % m_columns;
+    int row    = first / m_columns;
+    int origin, length, across, along;
+
+    if (vertical)
+    {
+        int x  = (column + 1) * m_clusterSize - 1;
+        int y  = row * m_clusterSize;
+        origin = y * grid.width() + x;
+        length = qMin(m_clusterSize, grid.height() - y);
+        across = 1;
+        along  = grid.width();
+    }
+    else
+    {
+        int x  = column * m_clusterSize;
+        int y  = (row + 1) * m_clusterSize - 1;
+        origin = y * grid.width() + x;
+        length = qMin(m_clusterSize, grid.width() - x);
+        across = grid.width();
+        along  = 1;
+    }
+
+    int runStart = -1;
+    for (int i = 0; i <= length; ++i)
+    {
+        int cell = origin + i * along;
+        bool open = i < length && !grid.isFilled(cell) && !grid.isFilled(cell + across);
+
+        if (open && runStart == -1)
+            runStart = i;
+
+        if (open || runStart == -1)
+            continue;
+
+        int runLength = i - runStart;
+        if (runLength < 6)
+        {
+            int middle = origin + (runStart + runLength / 2) * along;
+            result.push_back(qMakePair(middle, middle + across));
+        }
+        else
+        {
+            int head = origin + runStart * along;
+            int tail = origin + (i - 1) * along;
+            result.push_back(qMakePair(head, head + across));
+            result.push_back(qMakePair(tail, tail + across));
+        }
+
+        runStart = -1;
+    }
+}
+
+void HierarchicalSearch::searchCluster(const Grid &grid, int cluster, int from, int target, bool backward)
+{
+    m_local.prepare(grid.width() * grid.height());
+    PriorityQueue& open = m_local.open();
+
+    m_local.reach(from, 0, -1);
+    open.push(from, 0);
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        if (current == target)
+            return;
+
+        // Movement rules are symmetric: the cells, that can be reached from the current one, are the ones, that can reach it.
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next = neighbours[i];
+            if (!isInside(grid, next, cluster))
+                continue;
+
+            int step     = backward ? grid.stepCost(next, current) : grid.stepCost(current, next);
+            int new_cost = m_local.cost(current) + step;
+
+            if (m_local.isReached(next) && new_cost >= m_local.cost(next))
+                continue;
+
+            m_local.reach(next, new_cost, current);
+            open.push(next, new_cost);
+        }
+    }
+}
+
+void HierarchicalSearch::addEdge(const Heuristic &heuristic, const Node &goal, int current, int next, int cost)
+{
+    int new_cost = m_space.cost(current) + cost;
+
+    if (m_space.isReached(next) && new_cost >= m_space.cost(next))
+        return;
+
+    m_space.reach(next, new_cost, current);
+
+    Node node (next % m_width, next / m_width);
+    m_space.open().push(next, (qint64(new_cost + heuristic.estimate(node, goal)) << 32) - new_cost);
+}
+
+// Abstract edge either crosses the border (two cells are neighbours) or goes inside one cluster.
+// The latter is searched again, now only inside that cluster.
+QVector<Node> HierarchicalSearch::refine(const Grid &grid, const QVector<int> &corridor)
+{
+    QVector<Node> result;
+    result.push_back(grid.nodeAt(corridor.first()));
+
+    for (int i = 1; i < corridor.size(); ++i)
+    {
+        int from = corridor[i - 1];
+        int to   = corridor[i];
+        int cluster = clusterOf(grid, from);
+
+        if (cluster != clusterOf(grid, to))
+        {
+            result.push_back(grid.nodeAt(to));
+            continue;
+        }
+
+        searchCluster(grid, cluster, from, to, false);
+
+        QVector<Node> part = m_local.tracePath(grid, to);
+        for (int j = 1; j < part.size(); ++j)
+            result.push_back(part[j]);
+    }
+
+    return result;
+}
@@ -0,0 +1,92 @@
+#ifndef HIERARCHICALSEARCH_H
+#define HIERARCHICALSEARCH_H
+
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+#include "Graph/node.h"
+#include "heuristic.h"
+#include "searchspace.h"
+
+class Grid;
+
+// HierarchicalSearch is HPA* (hierarchical path-finding A*). The grid is split into square clusters.
+// Where two neighbouring clusters touch each other with unfilled cells, there are entrances: pairs of cells on both sides
+// of the border (one in the middle of the short opening, two at the ends of the long one).
+// For every cluster the costs of the paths between its entrances (that don't leave the cluster) are computed in advance.
+//
+// Query connects the start and the goal to the entrances of their clusters, searches the small abstract graph
+// of entrances and then refines only the chosen corridor: every abstract edge is turned into the path inside its cluster.
+// Found path is near-optimal: it may be a bit longer, than the shortest one, because it crosses the borders at entrances only.
+//
+// Abstract graph is kept between the queries. Changed cells (see Grid::changedCellsSince) make only their clusters
+// (and the neighbouring ones, if the border has changed) recompute their entrances and costs.
+class HierarchicalSearch
+{
+public:
+    static constexpr int DEFAULT_CLUSTER_SIZE = 10;
+    HierarchicalSearch(int clusterSize = DEFAULT_CLUSTER_SIZE);
+    ~HierarchicalSearch();
+
+    int  clusterSize () const;
+    void setClusterSize (int size);
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to, const Heuristic& heuristic);
+
+    // Statistics of the last search.
+    int pathCost () const;
+    int expandedCount () const;
+    int rebuiltClusters () const;
+
+private:
+    // Entrances of the cluster and the costs of the paths between them (-1, if there is no path inside the cluster).
+    // {links} connect entrances to the cells on the other side of the border.
+    struct Cluster
+    {
+        QVector<int>             entrances;
+        QVector<int>             costs;
+        QVector<QPair<int, int>> links;
+        bool                     outdated = true;
+    };
+
+    void update  (const Grid& grid);
+    void rebuild (const Grid& grid, int cluster);
+    void markCell(const Grid& grid, int cell);
+
+    int  clusterOf  (const Grid& grid, int cell) const;
+    bool isInside   (const Grid& grid, int cell, int cluster) const;
+    void transitions(const Grid& grid, int first, int second, QVector<QPair<int, int>>& result) const;
+
+    // Dijkstra search, that doesn't leave the {cluster}. It stops, as soon as the {target} is closed (-1 searches the whole cluster).
+    // Backward search goes from {from} against the edges: it finds the costs of paths from every cell to {from}.
+    void searchCluster (const Grid& grid, int cluster, int from, int target, bool backward);
+    void addEdge       (const Heuristic& heuristic, const Node& goal, int current, int next, int cost);
+
+    QVector<Node> refine (const Grid& grid, const QVector<int>& corridor);
+
+    int m_clusterSize;
+    int m_columns = 0;
+    int m_rows    = 0;
+
+    // Grid, the abstract graph was built for.
+    int  m_width    = -1;
+    int  m_height   = -1;
+    bool m_diagonal = false;
+    uint m_version  = 0;
+
+    QVector<Cluster> m_clusters;
+    QHash<int, int>  m_entranceIndex;
+
+    // Abstract search runs over the cells (only the start, the goal and entrances get there), local search is the one inside the cluster.
+    SearchSpace     m_space;
+    SearchSpace     m_local;
+    QHash<int, int> m_startEdges;
+    QHash<int, int> m_goalEdges;
+
+    int m_pathCost = -1;
+    int m_expandedCount = 0;
+    int m_rebuiltClusters = 0;
+};
+
+#endif // HIERARCHICALSEARCH_H
@@ -0,0 +1,273 @@
+#include "jumppointsearch.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+static inline int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+JumpPointSearch::JumpPointSearch()
+{
+
+}
+
+JumpPointSearch::~JumpPointSearch()
+{
+
+}
+
+QVector<Node> JumpPointSearch::shortestPath(const Grid &grid, const Node &from, const Node &to, const Heuristic &heuristic)
+{
+    m_space.prepare(grid.width() * grid.height());
+    m_pathCost = -1;
+    m_expandedCount = 0;
+
+    if (!grid.contains(from) || !grid.contains(to) || grid.isFilled(from) || grid.isFilled(to))
+    {
+        qDebug() << "Shortest path. JPS: start or goal node can't be traced.";
+        return QVector<Node>();
+    }
+
+    int start = grid.indexOf(from);
+    m_target  = grid.indexOf(to);
+
+    // Heap orders jump points by {cost + estimate}, preferring the ones, that are further from the start.
+    PriorityQueue& open = m_space.open();
+    m_space.reach(start, 0, -1);
+    open.push(start, qint64(heuristic.estimate(from, to)) << 32);
+
+    int dx[Grid::MAX_NEIGHBOURS];
+    int dy[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        ++m_expandedCount;
+
+        if (current == m_target)
+        {
+            m_pathCost = m_space.cost(m_target);
+            qDebug() << QString("Shortest path. JPS: goal reached. Cost: %1. Expanded nodes: %2.").arg(m_pathCost).arg(m_expandedCount);
+
+            return tracePath(grid, m_target);
+        }
+
+        int x = current % grid.width();
+        int y = current / grid.width();
+
+        int count = directionsOf(grid, current, m_space.parent(current), dx, dy);
+        for (int i = 0; i < count; ++i)
+        {
+            int next = jump(grid, x, y, dx[i], dy[i]);
+            if (next == -1)
+                continue;
+
+            // All the cells between two jump points cost the same, so the cost of the line is the cost of its first step.
+            int steps    = qMax(qAbs(next % grid.width() - x), qAbs(next / grid.width() - y));
+            int new_cost = m_space.cost(current) + steps * grid.stepCost(current, grid.indexOf(Node(x + dx[i], y + dy[i])));
+
+            if (m_space.isReached(next) && new_cost >= m_space.cost(next))
+                continue;
+
+            m_space.reach(next, new_cost, current);
+            open.push(next, (qint64(new_cost + heuristic.estimate(grid.nodeAt(next), to)) << 32) - new_cost);
+        }
+    }
+
+    qDebug() << QString("Shortest path. JPS: goal can't be reached. Expanded nodes: %1.").arg(m_expandedCount);
+    return QVector<Node>();
+}
+
+int JumpPointSearch::pathCost() const
+{
+    return m_pathCost;
+}
+
+int JumpPointSearch::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+bool JumpPointSearch::isFree(const Grid &grid, int x, int y) const
+{
+    return x >= 0 && x < grid.width() && y >= 0 && y < grid.height() && !grid.isFilled(y * grid.width() + x);
+}
+
+// Cell is uniform, if all the unfilled cells around it have the same weight, as the cell itself.
+bool JumpPointSearch::isUniform(const Grid &grid, int x, int y) const
+{
+    int weight = grid.weightFor(y * grid.width() + x);
+
+    for (int ny = y - 1; ny <= y + 1; ++ny)
+        for (int nx = x - 1; nx <= x + 1; ++nx)
+            if (isFree(grid, nx, ny) && grid.weightFor(ny * grid.width() + nx) != weight)
+                return false;
+
+    return true;
+}
+
+int JumpPointSearch::jump(const Grid &grid, int x, int y, int dx, int dy) const
+{
+    if (dx == 0 || dy == 0)
+        return jumpStraight(grid, x, y, dx, dy);
+
+    // Diagonal line. Every its cell looks along both straight directions, and becomes the jump point, if they find anything.
+    // Diagonal step can't cut the corner of filled cell.
+    while (isFree(grid, x + dx, y) && isFree(grid, x, y + dy) && isFree(grid, x + dx, y + dy))
+    {
+        x += dx;
+        y += dy;
+
+        int cell = y * grid.width() + x;
+        if (cell == m_target || !isUniform(grid, x, y))
+            return cell;
+
+        if (jumpStraight(grid, x, y, dx, 0) != -1 || jumpStraight(grid, x, y, 0, dy) != -1)
+            return cell;
+    }
+
+    return -1;
+}
+
+int JumpPointSearch::jumpStraight(const Grid &grid, int x, int y, int dx, int dy) const
+{
+    bool diagonal = grid.diagonalMovement();
+
+    while (isFree(grid, x + dx, y + dy))
+    {
+        x += dx;
+        y += dy;
+
+        int cell = y * grid.width() + x;
+        if (cell == m_target || !isUniform(grid, x, y))
+            return cell;
+
+        // Forced neighbours: the cell beside the line is open, while the one behind it is filled.
+        // The shortest path to it may go only through this cell.
+        if (dx != 0)
+        {
+            if ((isFree(grid, x, y - 1) && !isFree(grid, x - dx, y - 1)) ||
+                (isFree(grid, x, y + 1) && !isFree(grid, x - dx, y + 1)))
+                return cell;
+        }
+        else
+        {
+            if ((isFree(grid, x - 1, y) && !isFree(grid, x - 1, y - dy)) ||
+                (isFree(grid, x + 1, y) && !isFree(grid, x + 1, y - dy)))
+                return cell;
+
+            // Without diagonal movement vertical lines play the role of diagonal ones: they look along horizontal lines.
+            if (!diagonal && (jumpStraight(grid, x, y, 1, 0) != -1 || jumpStraight(grid, x, y, -1, 0) != -1))
+                return cell;
+        }
+    }
+
+    return -1;
+}
+
+int JumpPointSearch::directionsOf(const Grid &grid, int cell, int parent, int *dx, int *dy) const
+{
+    int count = 0;
+    int x = cell % grid.width();
+    int y = cell / grid.width();
+
+    // The start and the cells near other terrain look everywhere, where the grid allows to move.
+    if (parent == -1 || !isUniform(grid, x, y))
+    {
+        int neighbours[Grid::MAX_NEIGHBOURS];
+        int neighbourCount = grid.unfilledNeighboursOf(cell, neighbours);
+
+        for (int i = 0; i < neighbourCount; ++i)
+        {
+            dx[count] = neighbours[i] % grid.width() - x;
+            dy[count] = neighbours[i] / grid.width() - y;
+            ++count;
+        }
+
+        return count;
+    }
+
+    // The others continue the line, they came from, and look at the sides (forced neighbours are among them).
+    // Going back is never shorter, than going there from the parent.
+    int px = sign(x - parent % grid.width());
+    int py = sign(y - parent / grid.width());
+
+    auto add = [&](int ndx, int ndy)
+    {
+        dx[count] = ndx;
+        dy[count] = ndy;
+        ++count;
+    };
+
+    if (px != 0 && py != 0)
+    {
+        bool horizontal = isFree(grid, x + px, y);
+        bool vertical   = isFree(grid, x, y + py);
+
+        if (horizontal)
+            add(px, 0);
+
+        if (vertical)
+            add(0, py);
+
+        if (horizontal && vertical && isFree(grid, x + px, y + py))
+            add(px, py);
+
+        return count;
+    }
+
+    // Side directions of the straight line.
+    int sx = py != 0 ? 1 : 0;
+    int sy = px != 0 ? 1 : 0;
+
+    bool ahead = isFree(grid, x + px, y + py);
+    bool left  = isFree(grid, x - sx, y - sy);
+    bool right = isFree(grid, x + sx, y + sy);
+
+    if (ahead)
+        add(px, py);
+
+    if (left)
+        add(-sx, -sy);
+
+    if (right)
+        add(sx, sy);
+
+    if (grid.diagonalMovement() && ahead)
+    {
+        if (left && isFree(grid, x + px - sx, y + py - sy))
+            add(px - sx, py - sy);
+
+        if (right && isFree(grid, x + px + sx, y + py + sy))
+            add(px + sx, py + sy);
+    }
+
+    return count;
+}
+
+// Jump points are connected by straight or diagonal lines. Every cell of the line is put into the path.
+QVector<Node> JumpPointSearch::tracePath(const Grid &grid, int target) const
+{
+    QVector<Node> result;
+
+    for (int cell = target; cell != -1; cell = m_space.parent(cell))
+    {
+        int parent = m_space.parent(cell);
+        Node node = grid.nodeAt(cell);
+        result.push_back(node);
+
+        if (parent == -1)
+            break;
+
+        int dx = sign(parent % grid.width() - node.x());
+        int dy = sign(parent / grid.width() - node.y());
+        for (Node step (node.x() + dx, node.y() + dy); grid.indexOf(step) != parent; step = Node(step.x() + dx, step.y() + dy))
+            result.push_back(step);
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
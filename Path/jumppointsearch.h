@@ -0,0 +1,52 @@
+#ifndef JUMPPOINTSEARCH_H
+#define JUMPPOINTSEARCH_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+#include "heuristic.h"
+#include "searchspace.h"
+
+class Grid;
+
+// JumpPointSearch is A* search, that doesn't open every cell on its way. Long runs of the same terrain have lots of
+// paths of equal cost, and plain A* expands all of them. Here the search moves in straight and diagonal lines
+// and stops only at jump points: the goal, the cells next to obstacles, where the new paths open (forced neighbours),
+// and the cells next to the terrain of other weight. Only jump points get into the open queue.
+//
+// Weighted-region variant: the line keeps going only through uniform cells (all unfilled cells around them cost the same).
+// Cells next to the change of terrain become jump points and open all their neighbours, so the path stays the shortest one.
+// Movement rules are the same as in the grid: 4 directions, or 8 directions without cutting corners.
+class JumpPointSearch
+{
+public:
+    JumpPointSearch();
+    ~JumpPointSearch();
+
+    QVector<Node> shortestPath (const Grid& grid, const Node& from, const Node& to, const Heuristic& heuristic);
+
+    // Statistics of the last search.
+    int pathCost () const;
+    int expandedCount () const;
+
+private:
+    bool isFree    (const Grid& grid, int x, int y) const;
+    bool isUniform (const Grid& grid, int x, int y) const;
+
+    // Moves from the cell {x, y} in direction {dx, dy} and returns the first jump point on the way or -1, if there is none.
+    int jump         (const Grid& grid, int x, int y, int dx, int dy) const;
+    int jumpStraight (const Grid& grid, int x, int y, int dx, int dy) const;
+
+    // Writes the directions, that are worth to look at from the {cell}, that was reached from the {parent}, and returns their count.
+    int directionsOf (const Grid& grid, int cell, int parent, int* dx, int* dy) const;
+
+    QVector<Node> tracePath (const Grid& grid, int target) const;
+
+    SearchSpace m_space;
+    int         m_target = -1;
+
+    int m_pathCost = -1;
+    int m_expandedCount = 0;
+};
+
+#endif // JUMPPOINTSEARCH_H
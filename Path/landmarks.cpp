@@ -0,0 +1,282 @@
+#include "landmarks.h"
+#include "grid.h"
+
+#include "Graph/priorityqueue.h"
+#include "Graph/bucketqueue.h"
+
+#include <QFile>
+#include <QDataStream>
+#include <QDebug>
+
+#include <climits>
+
+Landmarks::Landmarks()
+{
+
+}
+
+Landmarks::~Landmarks()
+{
+
+}
+
+void Landmarks::compute(const Grid &grid, int count)
+{
+    clear();
+
+    m_width       = grid.width();
+    m_height      = grid.height();
+    m_diagonal    = grid.diagonalMovement();
+    m_fingerprint = fingerprintOf(grid);
+    m_version     = grid.version();
+
+    int cells = m_width * m_height;
+
+    // Distance from every cell to the nearest landmark, that is already picked (-1, while no landmark can reach the cell).
+    QVector<int> nearest (cells, -1);
+
+    // The first landmark is the farthest cell from the first unfilled one (that is usually the corner of the map).
+    int seed = 0;
+    while (seed < cells && grid.isFilled(seed))
+        ++seed;
+
+    if (seed == cells)
+        return;
+
+    QVector<int> cost;
+    flood(grid, seed, false, cost);
+
+    int next = seed;
+    for (int cell = 0; cell < cells; ++cell)
+        if (cost[cell] > cost[next])
+            next = cell;
+
+    while (m_cells.size() < count && next != -1)
+    {
+        m_cells.push_back(next);
+        m_from.push_back(QVector<int>());
+        m_to.push_back(QVector<int>());
+
+        flood(grid, next, false, m_from.last());
+        flood(grid, next, true,  m_to.last());
+
+        // Next landmark is the cell, that is the farthest one from all the picked landmarks.
+        // Cells of other islands are infinitely far, so every island gets its landmark.
+        next = -1;
+        int farthest = 0;
+        for (int cell = 0; cell < cells; ++cell)
+        {
+            if (grid.isFilled(cell))
+                continue;
+
+            int distance = m_from.last()[cell];
+            if (distance != -1 && (nearest[cell] == -1 || distance < nearest[cell]))
+                nearest[cell] = distance;
+
+            int value = nearest[cell] == -1 ? INT_MAX : nearest[cell];
+            if (value > farthest)
+            {
+                farthest = value;
+                next = cell;
+            }
+        }
+    }
+
+    qDebug() << QString("Landmarks. %1 landmarks have been computed.").arg(m_cells.size());
+}
+
+void Landmarks::clear()
+{
+    m_width  = 0;
+    m_height = 0;
+    m_cells.clear();
+    m_from.clear();
+    m_to.clear();
+}
+
+int Landmarks::count() const
+{
+    return m_cells.size();
+}
+
+bool Landmarks::isEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+// Tables are computed (or loaded) for the current state of the grid, and it hasn't changed since then.
+bool Landmarks::isValidFor(const Grid &grid) const
+{
+    return !isEmpty() && m_version == grid.version() && m_width == grid.width() && m_height == grid.height() && m_diagonal == grid.diagonalMovement();
+}
+
+QVector<Node> Landmarks::nodes() const
+{
+    QVector<Node> result;
+
+    foreach (int cell, m_cells)
+        result.push_back(Node(cell % m_width, cell / m_width));
+
+    return result;
+}
+
+int Landmarks::estimate(const Node &from, const Node &to) const
+{
+    int v = from.y() * m_width + from.x();
+    int t = to.y()   * m_width + to.x();
+
+    int result = 0;
+    for (int i = 0; i < m_cells.size(); ++i)
+    {
+        const QVector<int>& fromLandmark = m_from[i];
+        const QVector<int>& toLandmark   = m_to[i];
+
+        if (fromLandmark[v] != -1 && fromLandmark[t] != -1)
+            result = qMax(result, fromLandmark[t] - fromLandmark[v]);
+
+        if (toLandmark[v] != -1 && toLandmark[t] != -1)
+            result = qMax(result, toLandmark[v] - toLandmark[t]);
+    }
+
+    return result;
+}
+
+bool Landmarks::save(const QString &filename) const
+{
+    QFile file (filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << QString("Landmarks. Could not write file %1.").arg(filename);
+        return false;
+    }
+
+    QDataStream stream (&file);
+    stream << FILE_MAGIC << FILE_VERSION;
+    stream << qint32(m_width) << qint32(m_height) << m_diagonal << m_fingerprint;
+    stream << m_cells << m_from << m_to;
+
+    file.close();
+    return true;
+}
+
+bool Landmarks::load(const QString &filename, const Grid &grid)
+{
+    QFile file (filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream (&file);
+
+    quint32 magic, version, fingerprint;
+    qint32  width, height;
+    bool    diagonal;
+    stream >> magic >> version >> width >> height >> diagonal >> fingerprint;
+
+    if (stream.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION)
+    {
+        qDebug() << QString("Landmarks. File %1 is not a landmarks file.").arg(filename);
+        return false;
+    }
+
+    if (width != grid.width() || height != grid.height() || diagonal != grid.diagonalMovement() || fingerprint != fingerprintOf(grid))
+    {
+        qDebug() << QString("Landmarks. File %1 was saved for the other map.").arg(filename);
+        return false;
+    }
+
+    QVector<int>          cells;
+    QVector<QVector<int>> from;
+    QVector<QVector<int>> to;
+    stream >> cells >> from >> to;
+
+    if (stream.status() != QDataStream::Ok || from.size() != cells.size() || to.size() != cells.size())
+    {
+        qDebug() << QString("Landmarks. File %1 is corrupted.").arg(filename);
+        return false;
+    }
+
+    for (int i = 0; i < cells.size(); ++i)
+        if (from[i].size() != width * height || to[i].size() != width * height)
+            return false;
+
+    m_width       = width;
+    m_height      = height;
+    m_diagonal    = diagonal;
+    m_fingerprint = fingerprint;
+    m_version     = grid.version();
+    m_cells       = cells;
+    m_from        = from;
+    m_to          = to;
+
+    qDebug() << QString("Landmarks. %1 landmarks have been loaded from %2.").arg(m_cells.size()).arg(filename);
+    return true;
+}
+
+// FNV-1a hash of the size of the grid, its movement rules and the state of every cell.
+quint32 Landmarks::fingerprintOf(const Grid &grid)
+{
+    quint32 hash = 2166136261u;
+    auto mix = [&hash](quint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 16777619u;
+        }
+    };
+
+    mix(grid.width());
+    mix(grid.height());
+    mix(grid.diagonalMovement());
+
+    for (int cell = 0; cell < grid.width() * grid.height(); ++cell)
+        mix(grid.isFilled(cell) ? 0xFFFFFFFFu : quint32(grid.weightFor(cell)));
+
+    return hash;
+}
+
+void Landmarks::flood(const Grid &grid, int root, bool backward, QVector<int> &cost) const
+{
+    int cells = grid.width() * grid.height();
+
+    if (grid.maximumStepCost() <= BucketQueue::MAX_STEP)
+    {
+        BucketQueue open (cells, grid.maximumStepCost());
+        flood(grid, root, backward, cost, open);
+    }
+    else
+    {
+        PriorityQueue open (cells);
+        flood(grid, root, backward, cost, open);
+    }
+}
+
+// Dijkstra search over the whole grid. Backward search finds the costs of the paths to the {root}:
+// it goes against the edges, so the step from the cell to its neighbour costs the weight of the cell itself.
+template <typename Queue>
+void Landmarks::flood(const Grid &grid, int root, bool backward, QVector<int> &cost, Queue &open) const
+{
+    cost.fill(-1, grid.width() * grid.height());
+    cost[root] = 0;
+    open.push(root, 0);
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next     = neighbours[i];
+            int step     = backward ? grid.stepCost(next, current) : grid.stepCost(current, next);
+            int new_cost = cost[current] + step;
+
+            if (cost[next] != -1 && new_cost >= cost[next])
+                continue;
+
+            cost[next] = new_cost;
+            open.push(next, new_cost);
+        }
+    }
+}
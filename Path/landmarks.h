@@ -0,0 +1,64 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <QVector>
+#include <QString>
+
+#include "Graph/node.h"
+
+class Grid;
+
+// Landmarks hold exact costs of the paths from a few landmark cells to every cell of the grid and back (ALT heuristic).
+// By triangle inequality the path from {v} to {t} costs at least {d(L, t) - d(L, v)} and {d(v, L) - d(t, L)} for every landmark L.
+// The best of these bounds is much closer to the real cost, than the distance, when the terrain is expensive.
+// Steps are not symmetric (the step costs the weight of the cell, it leads to), so both directions are kept.
+//
+// Landmarks are picked far from each other (every next one is the cell, that is the farthest one from those, that are picked).
+// Tables are valid only for the grid, they were computed for: any edit makes them outdated.
+// They are expensive to compute, so for static maps they are saved to the file next to the map and loaded at startup.
+class Landmarks
+{
+public:
+    static constexpr int DEFAULT_COUNT = 8;
+    Landmarks();
+    ~Landmarks();
+
+    void compute (const Grid& grid, int count = DEFAULT_COUNT);
+    void clear   ();
+
+    int  count   () const;
+    bool isEmpty () const;
+    bool isValidFor (const Grid& grid) const;
+    QVector<Node> nodes () const;
+
+    // Lower bound of the cost of the path between two cells (0, if landmarks know nothing about them).
+    int estimate (const Node& from, const Node& to) const;
+
+    // Tables are saved together with the fingerprint of the grid (its size, movement rules, filled cells and weights).
+    // Loading fails, if the file was saved for the other grid.
+    bool save (const QString& filename) const;
+    bool load (const QString& filename, const Grid& grid);
+
+    static quint32 fingerprintOf (const Grid& grid);
+
+private:
+    template <typename Queue>
+    void flood (const Grid& grid, int root, bool backward, QVector<int>& cost, Queue& open) const;
+    void flood (const Grid& grid, int root, bool backward, QVector<int>& cost) const;
+
+    static constexpr quint32 FILE_MAGIC   = 0x414C5431; // "ALT1"
+    static constexpr quint32 FILE_VERSION = 1;
+
+    int     m_width  = 0;
+    int     m_height = 0;
+    bool    m_diagonal = false;
+    quint32 m_fingerprint = 0;
+    uint    m_version = 0;
+
+    // For every landmark: its cell, costs of the paths from it ({m_from}) and to it ({m_to}), -1 for unreachable cells.
+    QVector<int>          m_cells;
+    QVector<QVector<int>> m_from;
+    QVector<QVector<int>> m_to;
+};
+
+#endif // LANDMARKS_H
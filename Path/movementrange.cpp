@@ -0,0 +1,160 @@
+#include "movementrange.h"
+#include "searchspace.h"
+#include "grid.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+MovementRange::MovementRange()
+{
+
+}
+
+MovementRange::~MovementRange()
+{
+
+}
+
+void MovementRange::compute(const Grid &grid, const Node &origin, int budget, SearchSpace &space)
+{
+    m_origin = origin;
+    m_budget = budget;
+    m_width  = grid.width();
+    m_height = grid.height();
+    m_cells.clear();
+    m_costs.clear();
+
+    if (budget < 0 || !grid.contains(origin) || grid.isFilled(origin))
+        return;
+
+    space.prepare(m_width * m_height);
+
+    if (grid.maximumStepCost() <= BucketQueue::MAX_STEP)
+    {
+        space.buckets().setMaxStep(grid.maximumStepCost());
+        flood(grid, grid.indexOf(origin), space, space.buckets());
+    }
+    else
+        flood(grid, grid.indexOf(origin), space, space.open());
+
+    // Sort the cells by index, so that the cost of any cell can be found by binary search.
+    QVector<int> order (m_cells.size());
+    for (int i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), [this](int lhs, int rhs) { return m_cells[lhs] < m_cells[rhs]; });
+
+    QVector<int> cells (m_cells.size());
+    QVector<int> costs (m_costs.size());
+    for (int i = 0; i < order.size(); ++i)
+    {
+        cells[i] = m_cells[order[i]];
+        costs[i] = m_costs[order[i]];
+    }
+
+    m_cells = cells;
+    m_costs = costs;
+
+    qDebug() << QString("Movement range. %1 cells can be reached from %2 with %3 action points.").arg(m_cells.size()).arg(origin.toString()).arg(budget);
+}
+
+template <typename Queue>
+void MovementRange::flood(const Grid &grid, int origin, SearchSpace &space, Queue &open)
+{
+    // Dijkstra search, that never opens the cells, which cost more than the budget.
+    // Cells are picked in order of their costs, so the picked cell has its final cost.
+    space.reach(origin, 0, -1);
+    open.push(origin, 0);
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!open.isEmpty())
+    {
+        int current = open.pop();
+        m_cells.push_back(current);
+        m_costs.push_back(space.cost(current));
+
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int next     = neighbours[i];
+            int new_cost = space.cost(current) + grid.stepCost(current, next);
+
+            if (new_cost > m_budget)
+                continue;
+
+            if (space.isReached(next) && new_cost >= space.cost(next))
+                continue;
+
+            space.reach(next, new_cost, current);
+            open.push(next, new_cost);
+        }
+    }
+}
+
+const Node &MovementRange::origin() const
+{
+    return m_origin;
+}
+
+int MovementRange::budget() const
+{
+    return m_budget;
+}
+
+int MovementRange::size() const
+{
+    return m_cells.size();
+}
+
+bool MovementRange::isEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+bool MovementRange::contains(const Node &node) const
+{
+    return find(node) != -1;
+}
+
+int MovementRange::costTo(const Node &node) const
+{
+    int position = find(node);
+    return position != -1 ? m_costs[position] : -1;
+}
+
+const QVector<int> &MovementRange::cells() const
+{
+    return m_cells;
+}
+
+const QVector<int> &MovementRange::costs() const
+{
+    return m_costs;
+}
+
+QVector<Node> MovementRange::nodes() const
+{
+    QVector<Node> result;
+    result.reserve(m_cells.size());
+
+    foreach (int cell, m_cells)
+        result.push_back(Node(cell % m_width, cell / m_width));
+
+    return result;
+}
+
+// Returns the position of the {node} in the compact arrays or -1, if it is out of range.
+int MovementRange::find(const Node &node) const
+{
+    if (node.x() < 0 || node.x() >= m_width || node.y() < 0 || node.y() >= m_height)
+        return -1;
+
+    int cell = node.y() * m_width + node.x();
+
+    QVector<int>::const_iterator it = std::lower_bound(m_cells.begin(), m_cells.end(), cell);
+    if (it == m_cells.end() || *it != cell)
+        return -1;
+
+    return int(it - m_cells.begin());
+}
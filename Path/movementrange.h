@@ -0,0 +1,51 @@
+#ifndef MOVEMENTRANGE_H
+#define MOVEMENTRANGE_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+
+class Grid;
+class SearchSpace;
+
+// MovementRange holds all the cells, that the unit standing at the origin can reach, spending not more than {budget} action points.
+// It is computed by Dijkstra search, that stops at the budget, so it touches only the cells in range (and their neighbours),
+// not the whole map. Cells and their costs are kept in two compact arrays, sorted by the cell index.
+class MovementRange
+{
+public:
+    MovementRange();
+    ~MovementRange();
+
+    // {space} is the scratch space of the search. It is reused between the queries, so that they don't allocate per-cell data.
+    void compute (const Grid& grid, const Node& origin, int budget, SearchSpace& space);
+
+    const Node& origin () const;
+    int  budget  () const;
+    int  size    () const;
+    bool isEmpty () const;
+
+    bool contains (const Node& node) const;
+    int  costTo   (const Node& node) const;
+
+    // Cell indices of the grid (y * width + x) and the costs of reaching them.
+    const QVector<int>& cells () const;
+    const QVector<int>& costs () const;
+    QVector<Node>       nodes () const;
+
+private:
+    template <typename Queue>
+    void flood (const Grid& grid, int origin, SearchSpace& space, Queue& open);
+
+    int find (const Node& node) const;
+
+    Node m_origin;
+    int  m_budget = 0;
+    int  m_width  = 0;
+    int  m_height = 0;
+
+    QVector<int> m_cells;
+    QVector<int> m_costs;
+};
+
+#endif // MOVEMENTRANGE_H
@@ -0,0 +1,86 @@
+#include "reservationtable.h"
+
+ReservationTable::ReservationTable()
+{
+
+}
+
+ReservationTable::~ReservationTable()
+{
+
+}
+
+void ReservationTable::clear()
+{
+    m_reserved.clear();
+    m_parked.clear();
+    m_lastTime.clear();
+}
+
+bool ReservationTable::isEmpty() const
+{
+    return m_reserved.isEmpty() && m_parked.isEmpty();
+}
+
+void ReservationTable::reserve(int cell, int time, int agent)
+{
+    m_reserved.insert(keyOf(cell, time), agent);
+    m_lastTime.insert(cell, qMax(time, m_lastTime.value(cell, -1)));
+}
+
+void ReservationTable::park(int cell, int time, int agent)
+{
+    m_parked.insert(cell, qMakePair(time, agent));
+}
+
+void ReservationTable::unpark(int cell)
+{
+    m_parked.remove(cell);
+}
+
+int ReservationTable::agentAt(int cell, int time) const
+{
+    QPair<int, int> parked = m_parked.value(cell, qMakePair(-1, -1));
+    if (parked.second != -1 && parked.first <= time)
+        return parked.second;
+
+    return m_reserved.value(keyOf(cell, time), -1);
+}
+
+bool ReservationTable::canMove(int from, int to, int time, int agent) const
+{
+    int next = agentAt(to, time + 1);
+    if (next != -1 && next != agent)
+        return false;
+
+    // Waiting in place can't be a swap.
+    if (from == to)
+        return true;
+
+    int other = agentAt(to, time);
+    return other == -1 || other == agent || agentAt(from, time + 1) != other;
+}
+
+bool ReservationTable::canPark(int cell, int time, int agent) const
+{
+    int parked = agentAt(cell, time);
+    if (parked != -1 && parked != agent)
+        return false;
+
+    // The cell must not be crossed by the other agent later.
+    int last = m_lastTime.value(cell, -1);
+    for (int t = time + 1; t <= last; ++t)
+    {
+        int other = agentAt(cell, t);
+        if (other != -1 && other != agent)
+            return false;
+    }
+
+    return true;
+}
+
+// Time step takes the higher half of the key, cell index takes the lower one.
+quint64 ReservationTable::keyOf(int cell, int time)
+{
+    return (quint64(quint32(time)) << 32) | quint32(cell);
+}
@@ -0,0 +1,44 @@
+#ifndef RESERVATIONTABLE_H
+#define RESERVATIONTABLE_H
+
+#include <QHash>
+#include <QPair>
+
+// ReservationTable remembers, which cells are taken by agents at which time steps, so that the paths of the agents,
+// that are planned later, don't collide with the paths, that are planned already.
+// Every claim is a single hash entry: cell index and time step are packed into one 64-bit key.
+// Agent, that has reached its goal, stays there: the goal is parked (taken from that time step on, forever).
+class ReservationTable
+{
+public:
+    ReservationTable();
+    ~ReservationTable();
+
+    void clear ();
+    bool isEmpty () const;
+
+    void reserve (int cell, int time, int agent);
+    void park    (int cell, int time, int agent);
+    void unpark  (int cell);
+
+    // Agent, that takes the {cell} at the {time} (-1, if it is free).
+    int  agentAt (int cell, int time) const;
+
+    // Checks, if the {agent} may step from {from} to {to} between {time} and {time + 1}:
+    // the cell must be free at the next step, and the other agent must not be stepping the other way (they would swap).
+    bool canMove (int from, int to, int time, int agent) const;
+
+    // Checks, if the {agent} may stay in the {cell} forever, starting at the {time}.
+    bool canPark (int cell, int time, int agent) const;
+
+    static quint64 keyOf (int cell, int time);
+
+private:
+    QHash<quint64, int> m_reserved;
+
+    // Parked agents and the time they have arrived, the last reserved time step of every cell.
+    QHash<int, QPair<int, int>> m_parked;
+    QHash<int, int>             m_lastTime;
+};
+
+#endif // RESERVATIONTABLE_H
@@ -0,0 +1,122 @@
+#include "reversesearch.h"
+#include "grid.h"
+
+#include <algorithm>
+#include <functional>
+
+ReverseSearch::ReverseSearch()
+{
+
+}
+
+ReverseSearch::~ReverseSearch()
+{
+
+}
+
+void ReverseSearch::reset(const Grid &grid, int goal)
+{
+    Heuristic::Type type = grid.diagonalMovement() ? Heuristic::Type::OCTILE : Heuristic::Type::MANHATTAN;
+
+    m_goal      = goal;
+    m_origin    = goal;
+    m_version   = grid.version();
+    m_heuristic = Heuristic(type, grid.minimumWeight());
+
+    m_cost.clear();
+    m_closed.clear();
+    m_open.clear();
+    m_expandedCount = 0;
+
+    m_cost.insert(goal, 0);
+    m_open.push_back(qMakePair(priorityFor(grid, goal, 0), goal));
+}
+
+int ReverseSearch::goal() const
+{
+    return m_goal;
+}
+
+bool ReverseSearch::isValidFor(const Grid &grid) const
+{
+    return m_goal != -1 && m_version == grid.version();
+}
+
+// Costs of the closed cells don't depend on the estimate, so only the heap is built again.
+void ReverseSearch::setOrigin(const Grid &grid, int origin)
+{
+    if (origin == m_origin)
+        return;
+
+    m_origin = origin;
+
+    QVector<QPair<qint64, int>> open;
+    QHash<int, bool>            queued;
+    for (int i = 0; i < m_open.size(); ++i)
+    {
+        int cell = m_open.at(i).second;
+        if (m_closed.contains(cell) || queued.contains(cell))
+            continue;
+
+        queued.insert(cell, true);
+        open.push_back(qMakePair(priorityFor(grid, cell, m_cost.value(cell)), cell));
+    }
+
+    m_open = open;
+    std::make_heap(m_open.begin(), m_open.end(), std::greater<QPair<qint64, int>>());
+}
+
+// The step from {neighbour} to {cell} costs the weight of the {cell}, so the search goes against the steps.
+int ReverseSearch::costOf(const Grid &grid, int cell)
+{
+    if (m_closed.contains(cell))
+        return m_cost.value(cell);
+
+    int neighbours[Grid::MAX_NEIGHBOURS];
+    while (!m_open.isEmpty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<QPair<qint64, int>>());
+        QPair<qint64, int> entry = m_open.takeLast();
+
+        int current = entry.second;
+        int cost    = m_cost.value(current);
+
+        // The cell was queued again with lower cost or closed already, this entry is stale.
+        if (m_closed.contains(current) || entry.first != priorityFor(grid, current, cost))
+            continue;
+
+        m_closed.insert(current, true);
+        ++m_expandedCount;
+
+        int count = grid.unfilledNeighboursOf(current, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            int neighbour = neighbours[i];
+            int next_cost = cost + grid.stepCost(neighbour, current);
+
+            int known = m_cost.value(neighbour, -1);
+            if (known != -1 && known <= next_cost)
+                continue;
+
+            m_cost.insert(neighbour, next_cost);
+            m_open.push_back(qMakePair(priorityFor(grid, neighbour, next_cost), neighbour));
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<QPair<qint64, int>>());
+        }
+
+        if (current == cell)
+            return cost;
+    }
+
+    return -1;
+}
+
+int ReverseSearch::expandedCount() const
+{
+    return m_expandedCount;
+}
+
+// Heap orders cells by {cost + estimate} and resolves equal ones in favour of the cell, that is further from the goal.
+qint64 ReverseSearch::priorityFor(const Grid &grid, int cell, int cost) const
+{
+    return (qint64(cost + m_heuristic.estimate(grid.nodeAt(cell), grid.nodeAt(m_origin))) << 32) - cost;
+}
@@ -0,0 +1,54 @@
+#ifndef REVERSESEARCH_H
+#define REVERSESEARCH_H
+
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+#include "heuristic.h"
+
+class Grid;
+
+// ReverseSearch gives the exact cost of the path from any cell to one goal, computing only as much, as it is asked for
+// (Reverse Resumable A*): A* runs from the goal against the steps and stops, as soon as the asked cell is closed.
+// The next question resumes the same search, so the cells, that are closed already, are answered in O(1).
+// Estimate leads the search to the {origin} cell (the start of the agent), so it opens the cells around the path only.
+// Costs are kept in hashes, so the search takes memory only for the cells, it has reached.
+// Search remembers the version of the grid, it was started for, so it is known, when it gets outdated.
+class ReverseSearch
+{
+public:
+    ReverseSearch();
+    ~ReverseSearch();
+
+    // Starts the new search from the {goal} on the current state of the {grid}.
+    void reset (const Grid& grid, int goal);
+
+    int  goal () const;
+    bool isValidFor (const Grid& grid) const;
+
+    // Open cells are ordered again, when the {origin} changes, so the cells, that are closed already, are kept.
+    void setOrigin (const Grid& grid, int origin);
+
+    // Cost of the path from the {cell} to the goal or -1, if it can't reach the goal.
+    int costOf (const Grid& grid, int cell);
+
+    int expandedCount () const;
+
+private:
+    qint64 priorityFor (const Grid& grid, int cell, int cost) const;
+
+    int       m_goal    = -1;
+    int       m_origin  = -1;
+    uint      m_version = 0;
+    Heuristic m_heuristic;
+
+    // Best known cost of every reached cell ({m_closed} holds the exact ones)
+    // and the heap of open cells with their priorities (stale entries are skipped, when popped).
+    QHash<int, int>               m_cost;
+    QHash<int, bool>              m_closed;
+    QVector<QPair<qint64, int>>   m_open;
+    int                           m_expandedCount = 0;
+};
+
+#endif // REVERSESEARCH_H
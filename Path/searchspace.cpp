@@ -0,0 +1,96 @@
+#include "searchspace.h"
+#include "grid.h"
+
+#include <algorithm>
+
+SearchSpace::SearchSpace()
+{
+
+}
+
+SearchSpace::~SearchSpace()
+{
+
+}
+
+void SearchSpace::prepare(int cellCount)
+{
+    // Grid has changed its size. Per-cell data should be allocated again.
+    if (m_slots.capacity() != cellCount)
+    {
+        m_slots.reset(cellCount);
+        m_cost.clear();
+        m_parent.clear();
+        m_stamp.clear();
+        m_open.reset(cellCount);
+        m_buckets.reset(cellCount);
+        m_currentStamp = 0;
+    }
+
+    m_open.clear();
+    m_buckets.clear();
+
+    // Stamps are used up. Clear the old ones, so that they are not mixed with new ones.
+    if (++m_currentStamp == 0)
+    {
+        m_stamp.fill(0);
+        m_currentStamp = 1;
+    }
+}
+
+bool SearchSpace::isReached(int cell) const
+{
+    int slot = m_slots.slotOf(cell);
+    return slot != -1 && m_stamp[slot] == m_currentStamp;
+}
+
+int SearchSpace::cost(int cell) const
+{
+    int slot = m_slots.slotOf(cell);
+    return slot != -1 && m_stamp[slot] == m_currentStamp ? m_cost[slot] : -1;
+}
+
+int SearchSpace::parent(int cell) const
+{
+    int slot = m_slots.slotOf(cell);
+    return slot != -1 && m_stamp[slot] == m_currentStamp ? m_parent[slot] : -1;
+}
+
+// The block, that is reached for the first time, gets its place at the end of the per-cell data.
+// Blocks are kept for the next searches, they are just stamped again.
+void SearchSpace::reach(int cell, int cost, int parent)
+{
+    int slot = m_slots.allocate(cell);
+
+    if (slot >= m_stamp.size())
+    {
+        m_cost.resize(m_slots.slotCount());
+        m_parent.resize(m_slots.slotCount());
+        m_stamp.resize(m_slots.slotCount());
+    }
+
+    m_stamp[slot]  = m_currentStamp;
+    m_cost[slot]   = cost;
+    m_parent[slot] = parent;
+}
+
+PriorityQueue &SearchSpace::open()
+{
+    return m_open;
+}
+
+BucketQueue &SearchSpace::buckets()
+{
+    return m_buckets;
+}
+
+QVector<Node> SearchSpace::tracePath(const Grid &grid, int target) const
+{
+    QVector<Node> result;
+
+    for (int cell = target; cell != -1; cell = parent(cell))
+        result.push_back(grid.nodeAt(cell));
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef SEARCHSPACE_H
+#define SEARCHSPACE_H
+
+#include <QVector>
+
+#include "Graph/node.h"
+#include "Graph/blockmap.h"
+#include "Graph/priorityqueue.h"
+#include "Graph/bucketqueue.h"
+
+class Grid;
+
+// SearchSpace is a scratch buffer for the search on the grid: cost and parent of every cell and the queue of open cells
+// (binary heap or buckets, whichever suits the search).
+// It is kept between the searches, so that a query doesn't allocate anything, unless it reaches the cells, that no search
+// has reached before: per-cell data and the indices of both queues are allocated by blocks of consecutive cells
+// (see BlockMap) at the first reach of the block, so the search on the big map takes memory only for the parts of it,
+// that its frontier has reached.
+// Instead of clearing the per-cell data, every search gets its own stamp: cell data with an old stamp is treated as unreached.
+class SearchSpace
+{
+public:
+    SearchSpace();
+    ~SearchSpace();
+
+    // Prepares the space for the new search on the grid with {cellCount} cells.
+    void prepare (int cellCount);
+
+    bool isReached (int cell) const;
+    int  cost      (int cell) const;
+    int  parent    (int cell) const;
+    void reach     (int cell, int cost, int parent);
+
+    PriorityQueue& open();
+    BucketQueue&   buckets();
+
+    // Returns the path from the start to the {target} cell, following remembered parents.
+    QVector<Node> tracePath (const Grid& grid, int target) const;
+
+private:
+    BlockMap      m_slots;
+    QVector<int>  m_cost;
+    QVector<int>  m_parent;
+    QVector<uint> m_stamp;
+    uint          m_currentStamp = 0;
+    PriorityQueue m_open;
+    BucketQueue   m_buckets;
+};
+
+#endif // SEARCHSPACE_H
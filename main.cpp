@@ -1,13 +1,27 @@
-#include "board.h"
-
-#include <QApplication>
-
-int main(int argc, char *argv[])
-{
-    QApplication a(argc, argv);
-
-    Board board;
-    board.show();
-
-    return a.exec();
-}
+#include "board.h"
+
+#include <QApplication>
+#include <QStringList>
+
+// Queries of the contraction hierarchy benchmark, when their count is not given.
+static const int DEFAULT_BENCHMARK_QUERIES = 100;
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+
+    Board board;
+
+    // --benchmark-ch [N] runs N random queries on the loaded map by the contraction hierarchy and by Dijkstra search.
+    QStringList arguments = a.arguments();
+    int option = arguments.indexOf("--benchmark-ch");
+    if (option != -1)
+    {
+        int queries = arguments.value(option + 1).toInt();
+        board.benchmarkContraction(queries > 0 ? queries : DEFAULT_BENCHMARK_QUERIES);
+    }
+
+    board.show();
+
+    return a.exec();
+}
@@ -1,204 +1,383 @@
-#include <QSize>
-#include <QPoint>
-
-// #include <QDebug>
-
-#include "mapmodel.h"
-MapModel::MapModel(int width, int height, const uint& cellsize)
-{
-    m_grid     = Grid(QSize(width, height));
-
-    m_mapSize  = QSize(width, height);
-    m_cellSize = cellsize;
-}
-
-MapModel::~MapModel()
-{
-
-}
-
-QVector<Node> MapModel::nodes() const
-{
-    QVector<Node> result;
-
-    // Since logic nodes now have view representation with some size,
-    // we need to update those values before returning the result.
-    foreach (Node node, m_grid.nodes())
-    {
-        node.setX(node.x() * cellsize());
-        node.setY(node.y() * cellsize());
-
-        result.push_back(node);
-    }
-
-    return result;
-}
-
-QVector<Node> MapModel::shortestPath (const Node& from, const Node& to) const
-{
-    qDebug() << QString("Shortest path. There are %1 nodes in the grid.").arg(m_grid.nodes().size());
-
-    return m_grid.shortestPath(from, to);
-}
-
-int MapModel::width() const
-{
-    return cellsInRow() * cellsize();
-}
-
-int MapModel::height() const
-{
-    return cellsInColumn() * cellsize();
-}
-
-int MapModel::cellsize() const
-{
-    return m_cellSize;
-}
-
-int MapModel::cellsInRow() const
-{
-    return m_mapSize.width();
-}
-
-int MapModel::cellsInColumn() const
-{
-    return m_mapSize.height();
-}
-
-void MapModel::resizeMap(int width, int height)
-{
-    qDebug() << "here: " << width << "," << height;
-
-    /*
-    bool  widthAllowed = (width  >= 0 && width  <= MAX_WIDTH);
-    bool heightAllowed = (height >= 0 && height <= MAX_HEIGHT);
-
-    if (!widthAllowed)
-    {
-        qDebug() << "Width is not allowed. Make sure it is in allowed intervals.";
-        return;
-    }
-
-    if (!heightAllowed)
-    {
-        qDebug() << "Height is not allowed. Make sure it is in allowed intervals.";
-        return;
-    }
-    */
-
-    m_mapSize.setWidth(width);
-    m_mapSize.setHeight(height);
-
-    // qDebug() << m_mapSize.width() << ":" << m_mapSize.height();
-}
-
-void MapModel::resizeCell(int size)
-{
-    bool sizeAllowed = (size >= 0 && size <= MAX_CELLSIZE);
-
-    if (!sizeAllowed)
-    {
-        qDebug() << "Size is not allowed";
-        return;
-    }
-
-    m_cellSize = size;
-}
-
-void MapModel::fillCell(const QPoint &position)
-{
-    m_grid.fill(position);
-}
-
-void MapModel::fillAtMP(const QPoint &position)
-{
-    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
-
-    m_grid.fill(gridPosition);
-}
-
-void MapModel::unfillCell(const QPoint &position)
-{
-    m_grid.unfill(position);
-}
-
-void MapModel::unfillAtMP(const QPoint &position)
-{
-    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
-
-    m_grid.unfill(gridPosition);
-}
-
-bool MapModel::isFilledCell(const QPoint &position)
-{
-    return m_grid.isFilled(position);
-}
-
-void MapModel::setWeights(const QString &weightMap)
-{
-    qDebug() << weightMap.size() << ":" << m_mapSize.width() * m_mapSize.height();
-
-    // If the size of the weight map is not the same as the size of the map itself, it is not allowed to use.
-    if (weightMap.size() != m_mapSize.width() * m_mapSize.height())
-    {
-        qDebug() << "Weight map can't be used for this map";
-        return;
-    }
-
-    // Resize the logic grid, if needed.
-    m_grid.resize(m_mapSize.width(), m_mapSize.height());
-
-    qDebug() << "After resize";
-
-    // Place parsed weight value to each node of the logic grid.
-    int index = 0;
-    for (int h = 0; h < m_mapSize.height(); ++h)
-    {
-        for (int w = 0; w < m_mapSize.width(); ++w)
-        {
-            int weight = 0;
-
-            QChar symbol = weightMap.at(index);
-            if (symbol.isDigit())
-                weight = symbol.digitValue();
-
-            qDebug() << QString("Setting weight for node {%1, %2}: %3").arg(w).arg(h).arg(weight);
-            setWeightForCell(QPoint(w,h), weight);
-
-            ++index;
-        }
-    }
-}
-
-void MapModel::setWeightForCell(const QPoint &position, int value)
-{
-    // Graph graph_copy = m_grid.graph();
-    Node node (position.x(), position.y());
-
-    if (value <= 0)
-        m_grid.fill(node);
-    m_grid.setWeightFor(node, value);
-}
-
-bool MapModel::isFilledAtMP(const QPoint &position)
-{
-    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
-
-    return m_grid.isFilled(gridPosition);
-}
-
-void MapModel::fillRow(int rowIndex)
-{
-    m_grid.fillRow(rowIndex);
-}
-
-void MapModel::fillColumn(int columnIndex)
-{
-    m_grid.fillColumn(columnIndex);
-}
-
-void MapModel::fillVector(const QVector<QVector<int> > &vector)
-{
-    m_grid.fillVector(vector);
-}
+#include <QSize>
+#include <QPoint>
+#include <QElapsedTimer>
+
+// #include <QDebug>
+
+#include "mapmodel.h"
+
+// Memory, that landmark tables may take.
+static const qint64 LANDMARKS_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+MapModel::MapModel(int width, int height, const uint& cellsize)
+{
+    m_grid     = Grid(QSize(width, height));
+
+    m_mapSize  = QSize(width, height);
+    m_cellSize = cellsize;
+}
+
+MapModel::~MapModel()
+{
+
+}
+
+QVector<Node> MapModel::nodes() const
+{
+    QVector<Node> result;
+
+    // Since logic nodes now have view representation with some size,
+    // we need to update those values before returning the result.
+    foreach (Node node, m_grid.nodes())
+    {
+        node.setX(node.x() * cellsize());
+        node.setY(node.y() * cellsize());
+
+        result.push_back(node);
+    }
+
+    return result;
+}
+
+QVector<Node> MapModel::shortestPath (const Node& from, const Node& to) const
+{
+    qDebug() << QString("Shortest path. There are %1 nodes in the grid.").arg(m_grid.width() * m_grid.height());
+
+    if (!areConnected(from, to))
+        return QVector<Node>();
+
+    if (m_searchMode == SearchMode::GRAPH)
+        return m_grid.shortestPath(from, to);
+
+    if (m_searchMode == SearchMode::FIELD)
+        return m_fields.shortestPath(m_grid, from, to);
+
+    if (m_searchMode == SearchMode::FLOW_FIELD)
+        return flowField(to).pathFrom(from);
+
+    if (m_searchMode == SearchMode::CONTRACTION)
+        return contractionHierarchy().shortestPath(from, to);
+
+    if (m_searchMode == SearchMode::BIDIRECTIONAL)
+        return m_bidirectionalSearch.shortestPath(m_grid, from, to, Heuristic(Heuristic::Type::ZERO));
+
+    Heuristic::Type type = m_grid.diagonalMovement() ? Heuristic::Type::OCTILE : Heuristic::Type::MANHATTAN;
+
+    if (m_searchMode == SearchMode::JUMP_POINTS)
+        return m_jumpSearch.shortestPath(m_grid, from, to, Heuristic(type, m_grid.minimumWeight()));
+
+    if (m_searchMode == SearchMode::HIERARCHICAL)
+        return m_hierarchicalSearch.shortestPath(m_grid, from, to, Heuristic(type, m_grid.minimumWeight()));
+
+    if (m_searchMode == SearchMode::REPLANNING)
+        return m_replanner.shortestPath(m_grid, from, to, Heuristic(type, m_grid.minimumWeight()));
+
+    // A* search straight on the grid.
+    return shortestPath(from, to, defaultHeuristic());
+}
+
+// A* search on the grid. Heuristic is scaled by the minimum weight of the grid.
+QVector<Node> MapModel::shortestPath(const Node &from, const Node &to, const Heuristic::Type &heuristic) const
+{
+    if (!areConnected(from, to))
+        return QVector<Node>();
+
+    // Outdated landmarks may overestimate the cost, so only valid ones are used.
+    const Landmarks* landmarks = m_landmarks.isValidFor(m_grid) ? &m_landmarks : nullptr;
+
+    return m_search.shortestPath(m_grid, from, to, Heuristic(heuristic, m_grid.minimumWeight(), landmarks, m_grid.diagonalMovement()));
+}
+
+QVector<QVector<Node>> MapModel::shortestPaths(const QVector<QPair<Node, Node>> &queries) const
+{
+    // Components are checked here, before the threads start: their labels are updated lazily, so they are not read concurrently.
+    QVector<bool> skipped (queries.size());
+    for (int i = 0; i < queries.size(); ++i)
+        skipped[i] = !areConnected(queries.at(i).first, queries.at(i).second);
+
+    const Landmarks* landmarks = m_landmarks.isValidFor(m_grid) ? &m_landmarks : nullptr;
+
+    return m_batchSearch.shortestPaths(m_grid, queries, skipped, Heuristic(defaultHeuristic(), m_grid.minimumWeight(), landmarks, m_grid.diagonalMovement()));
+}
+
+QVector<QVector<Node>> MapModel::cooperativePaths(const QVector<QPair<Node, Node>> &agents) const
+{
+    return m_cooperativeSearch.plan(m_grid, agents);
+}
+
+// Costs and paths from the {root} to every cell of the map. Field is cached until the map changes.
+const DistanceField &MapModel::distanceField(const Node &root) const
+{
+    return m_fields.fieldFor(m_grid, root);
+}
+
+const FlowField &MapModel::flowField(const Node &goal) const
+{
+    if (m_flowField.isEmpty() || m_flowField.goal() != goal)
+        m_flowField.compute(m_grid, goal);
+    else
+        m_flowField.update(m_grid);
+
+    return m_flowField;
+}
+
+MovementRange MapModel::movementRange(const Node &origin, int budget) const
+{
+    MovementRange result;
+    result.compute(m_grid, origin, budget, m_rangeSpace);
+
+    return result;
+}
+
+int MapModel::componentOf(const QPoint &position) const
+{
+    return m_grid.componentOf(Node(position.x(), position.y()));
+}
+
+bool MapModel::areConnected(const Node &from, const Node &to) const
+{
+    if (m_grid.areConnected(from, to))
+        return true;
+
+    qDebug() << QString("Shortest path. Nodes %1 and %2 are in different components, there is no path.").arg(from.toString()).arg(to.toString());
+    return false;
+}
+
+void MapModel::prepareLandmarks(const QString &filename)
+{
+    if (m_landmarks.load(filename, m_grid))
+        return;
+
+    qint64 table_size = qint64(m_grid.width()) * m_grid.height() * 2 * sizeof(int);
+    int    count      = Landmarks::DEFAULT_COUNT;
+    if (table_size > 0)
+        count = int(qMin(qint64(count), LANDMARKS_MEMORY_BUDGET / table_size));
+
+    if (count == 0)
+    {
+        qDebug() << QString("Landmarks. Map is too big for landmark tables, they are not used.");
+        m_landmarks.clear();
+        return;
+    }
+
+    m_landmarks.compute(m_grid, count);
+    m_landmarks.save(filename);
+}
+
+const Landmarks &MapModel::landmarks() const
+{
+    return m_landmarks;
+}
+
+bool MapModel::setPaging(const QString &pageFile, int residentChunks)
+{
+    if (!m_grid.setPageFile(pageFile))
+        return false;
+
+    m_grid.setChunkBudget(residentChunks);
+
+    qDebug() << QString("Map. Cells are paged to %1, %2 chunks are kept in memory.").arg(pageFile).arg(m_grid.residentChunkCount());
+    return true;
+}
+
+ContractionHierarchy &MapModel::contractionHierarchy() const
+{
+    if (m_contraction.isEmpty() || m_contractionVersion != m_grid.version())
+    {
+        m_contraction.build(m_grid.compactGraph());
+        m_contractionVersion = m_grid.version();
+    }
+
+    return m_contraction;
+}
+
+// Landmark tables give the tightest estimate, while they are valid for the map. Otherwise the distance suits the movement.
+Heuristic::Type MapModel::defaultHeuristic() const
+{
+    if (m_landmarks.isValidFor(m_grid))
+        return Heuristic::Type::LANDMARKS;
+
+    return m_grid.diagonalMovement() ? Heuristic::Type::OCTILE : Heuristic::Type::MANHATTAN;
+}
+
+ContractionHierarchy::Benchmark MapModel::benchmarkContraction(int queries) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    ContractionHierarchy& hierarchy = contractionHierarchy();
+    qDebug() << QString("Contraction hierarchy. Ready in %1 ms.").arg(timer.elapsed());
+
+    return hierarchy.benchmark(queries);
+}
+
+const MapModel::SearchMode &MapModel::searchMode() const
+{
+    return m_searchMode;
+}
+
+void MapModel::setSearchMode(const SearchMode &mode)
+{
+    m_searchMode = mode;
+}
+
+int MapModel::width() const
+{
+    return cellsInRow() * cellsize();
+}
+
+int MapModel::height() const
+{
+    return cellsInColumn() * cellsize();
+}
+
+int MapModel::cellsize() const
+{
+    return m_cellSize;
+}
+
+int MapModel::cellsInRow() const
+{
+    return m_mapSize.width();
+}
+
+int MapModel::cellsInColumn() const
+{
+    return m_mapSize.height();
+}
+
+void MapModel::resizeMap(int width, int height)
+{
+    qDebug() << "here: " << width << "," << height;
+
+    /*
+    bool  widthAllowed = (width  >= 0 && width  <= MAX_WIDTH);
+    bool heightAllowed = (height >= 0 && height <= MAX_HEIGHT);
+
+    if (!widthAllowed)
+    {
+        qDebug() << "Width is not allowed. Make sure it is in allowed intervals.";
+        return;
+    }
+
+    if (!heightAllowed)
+    {
+        qDebug() << "Height is not allowed. Make sure it is in allowed intervals.";
+        return;
+    }
+    */
+
+    m_mapSize.setWidth(width);
+    m_mapSize.setHeight(height);
+
+    // qDebug() << m_mapSize.width() << ":" << m_mapSize.height();
+}
+
+void MapModel::resizeCell(int size)
+{
+    bool sizeAllowed = (size >= 0 && size <= MAX_CELLSIZE);
+
+    if (!sizeAllowed)
+    {
+        qDebug() << "Size is not allowed";
+        return;
+    }
+
+    m_cellSize = size;
+}
+
+void MapModel::fillCell(const QPoint &position)
+{
+    m_grid.fill(position);
+}
+
+void MapModel::fillAtMP(const QPoint &position)
+{
+    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
+
+    m_grid.fill(gridPosition);
+}
+
+void MapModel::unfillCell(const QPoint &position)
+{
+    m_grid.unfill(position);
+}
+
+void MapModel::unfillAtMP(const QPoint &position)
+{
+    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
+
+    m_grid.unfill(gridPosition);
+}
+
+bool MapModel::isFilledCell(const QPoint &position)
+{
+    return m_grid.isFilled(position);
+}
+
+void MapModel::setWeights(const QString &weightMap)
+{
+    qDebug() << weightMap.size() << ":" << m_mapSize.width() * m_mapSize.height();
+
+    // If the size of the weight map is not the same as the size of the map itself, it is not allowed to use.
+    if (weightMap.size() != m_mapSize.width() * m_mapSize.height())
+    {
+        qDebug() << "Weight map can't be used for this map";
+        return;
+    }
+
+    // Resize the logic grid, if needed.
+    m_grid.resize(m_mapSize.width(), m_mapSize.height());
+
+    qDebug() << "After resize";
+
+    // Place parsed weight value to each node of the logic grid.
+    int index = 0;
+    for (int h = 0; h < m_mapSize.height(); ++h)
+    {
+        for (int w = 0; w < m_mapSize.width(); ++w)
+        {
+            int weight = 0;
+
+            QChar symbol = weightMap.at(index);
+            if (symbol.isDigit())
+                weight = symbol.digitValue();
+
+            setWeightForCell(QPoint(w,h), weight);
+
+            ++index;
+        }
+    }
+}
+
+void MapModel::setWeightForCell(const QPoint &position, int value)
+{
+    // Graph graph_copy = m_grid.graph();
+    Node node (position.x(), position.y());
+
+    if (value <= 0)
+        m_grid.fill(node);
+    m_grid.setWeightFor(node, value);
+}
+
+bool MapModel::isFilledAtMP(const QPoint &position)
+{
+    QPoint gridPosition = QPoint(position.x() / m_cellSize, position.y() / m_cellSize);
+
+    return m_grid.isFilled(gridPosition);
+}
+
+void MapModel::fillRow(int rowIndex)
+{
+    m_grid.fillRow(rowIndex);
+}
+
+void MapModel::fillColumn(int columnIndex)
+{
+    m_grid.fillColumn(columnIndex);
+}
+
+void MapModel::fillVector(const QVector<QVector<int> > &vector)
+{
+    m_grid.fillVector(vector);
+}
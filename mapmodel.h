@@ -1,63 +1,152 @@
-#ifndef MAPMODEL_H
-#define MAPMODEL_H
-
-#include "Path\grid.h"
-
-// Map class represents the region, filled with cells.
-// Each cell can be filled (tracable) or unfilled (untracable).
-// This class allows easy detection of shortest path between any two cells
-// depending on the weights these cells have.
-
-class MapModel
-{
-public:
-    MapModel(int width = 0 , int height = 0, const uint& cellsize = 50);
-    ~MapModel();
-
-    QVector<Node> nodes() const;
-    QVector<Node> shortestPath(const Node& from, const Node& to) const;
-
-    // Sizes of the map
-    int width() const;
-    int height() const;
-    int cellsize() const;
-    int cellsInRow() const;
-    int cellsInColumn() const;
-
-    void resizeMap  (int width, int height);
-    void resizeCell (int size);
-
-    // These operate on logic cell (1x1)
-    void fillCell     (const QPoint& position);
-    void unfillCell   (const QPoint& position);
-    bool isFilledCell (const QPoint& position);
-
-    // Set and check weights methods
-    void setWeights       (const QString& weightMap);
-    void setWeightForCell (const QPoint& position, int value);
-    int  weightOfCell     (const QPoint& position);
-
-    // These operate on view cell (that has some concrete size)
-    void fillAtMP     (const QPoint& position);
-    void unfillAtMP   (const QPoint& position);
-    bool isFilledAtMP (const QPoint& position);
-
-    void fillRow    (int row);
-    void fillColumn (int column);
-    void fillVector (const QVector<QVector<int> >& vector);
-
-private:
-    // Logic representation
-    Grid m_grid;
-
-    // Default constants
-    static constexpr int MAX_WIDTH = 50;
-    static constexpr int MAX_HEIGHT = 50;
-    static constexpr int MAX_CELLSIZE = 64;
-
-    // Sizes
-    QSize m_mapSize;
-    uint  m_cellSize;
-};
-
-#endif // MAP_H
+#ifndef MAPMODEL_H
+#define MAPMODEL_H
+
+#include "Path\grid.h"
+#include "Path/astar.h"
+#include "Path/distancefieldcache.h"
+#include "Path/flowfield.h"
+#include "Path/jumppointsearch.h"
+#include "Path/hierarchicalsearch.h"
+#include "Path/bidirectionalsearch.h"
+#include "Path/dstarlite.h"
+#include "Path/batchsearch.h"
+#include "Path/cooperativesearch.h"
+#include "Path/landmarks.h"
+#include "Path/movementrange.h"
+#include "Graph/contractionhierarchy.h"
+
+// Map class represents the region, filled with cells.
+// Each cell can be filled (tracable) or unfilled (untracable).
+// This class allows easy detection of shortest path between any two cells
+// depending on the weights these cells have.
+
+// Shortest path is searched on the grid directly by A* (GRID mode, default) or on the graph, that is built out of grid (GRAPH mode).
+// In FIELD mode the distance field of the start cell is computed once and kept, until the grid changes,
+// so that the paths from the same cell are just looked up.
+// JUMP_POINTS mode runs Jump Point Search, that skips the runs of the same terrain instead of opening every their cell.
+// HIERARCHICAL mode searches the graph of cluster entrances first (HPA*). It is the fastest one on big maps, but the path is near-optimal.
+// BIDIRECTIONAL mode runs Dijkstra search from both ends of the path at once.
+// REPLANNING mode runs D* Lite: the unit asks for the path to the same goal again and again, while it moves and the map changes,
+// and only the costs, that were changed by the edits, are repaired instead of the new search.
+// CONTRACTION mode queries the contraction hierarchy of the grid graph. It is built once (that is slow) and rebuilt only when the map changes,
+// so it suits the maps, that are loaded once and queried many times.
+// FLOW_FIELD mode keeps the flow field of the last goal: paths of all the units, that run to the same goal, are just walks
+// through its directions, and the changes of the map update only the part of the field, that they affect.
+class MapModel
+{
+public:
+    enum class SearchMode {GRID, GRAPH, FIELD, JUMP_POINTS, HIERARCHICAL, BIDIRECTIONAL, REPLANNING, CONTRACTION, FLOW_FIELD};
+    MapModel(int width = 0 , int height = 0, const uint& cellsize = 50);
+    ~MapModel();
+
+    QVector<Node> nodes() const;
+    QVector<Node> shortestPath(const Node& from, const Node& to) const;
+    QVector<Node> shortestPath(const Node& from, const Node& to, const Heuristic::Type& heuristic) const;
+
+    // Paths for the batch of {from, to} queries (f.e. for all the creatures, that move in this tick), in order of the queries.
+    // Queries are answered by A* concurrently, each thread with its own search data.
+    QVector<QVector<Node>> shortestPaths(const QVector<QPair<Node, Node>>& queries) const;
+
+    // Paths of the agents, that move at the same time, planned so that they never take the same cell at the same time step
+    // and never swap their cells. Agents are planned in order of the queries (the first one has the highest priority).
+    // Node {t} of the path is the cell at the time step {t}, waiting agent repeats its cell.
+    QVector<QVector<Node>> cooperativePaths(const QVector<QPair<Node, Node>>& agents) const;
+
+    const DistanceField& distanceField(const Node& root) const;
+
+    // Directions to the {goal} from every cell of the map, so that any number of units read their next step in O(1).
+    // Field of the last goal is kept and updated, when the map changes.
+    const FlowField& flowField(const Node& goal) const;
+
+    // All the cells, that can be reached from the {origin} with {budget} action points.
+    MovementRange movementRange(const Node& origin, int budget) const;
+
+    const SearchMode& searchMode() const;
+    void setSearchMode (const SearchMode& mode);
+
+    // Cells with equal labels have a path between them (filled cells have label -1).
+    // Queries between different components are answered without search.
+    int  componentOf  (const QPoint& position) const;
+    bool areConnected (const Node& from, const Node& to) const;
+
+    // Landmark tables for LANDMARKS heuristic. They are loaded from the {filename}, if it was saved for this map,
+    // otherwise they are computed and saved there. Tables are not used, when the map has changed since then.
+    // Every landmark takes two ints per cell, so the big maps get fewer landmarks (or none), to fit the memory budget.
+    void prepareLandmarks (const QString& filename);
+    const Landmarks& landmarks () const;
+
+    // Big maps may keep only {residentChunks} chunks of cells in memory (0 means no limit),
+    // the rest of them are paged out to the {pageFile} and read back, when the search reaches them.
+    bool setPaging (const QString& pageFile, int residentChunks);
+
+    // Contraction hierarchy of the grid graph. It is built at the first call and after every change of the map,
+    // so the batch jobs call it right after loading to keep the build out of the queries.
+    ContractionHierarchy& contractionHierarchy () const;
+
+    // Builds the contraction hierarchy, if needed, and compares its answers and times with Dijkstra search
+    // on {queries} random pairs of cells. Results are written to the log.
+    ContractionHierarchy::Benchmark benchmarkContraction (int queries) const;
+
+    // Sizes of the map
+    int width() const;
+    int height() const;
+    int cellsize() const;
+    int cellsInRow() const;
+    int cellsInColumn() const;
+
+    void resizeMap  (int width, int height);
+    void resizeCell (int size);
+
+    // These operate on logic cell (1x1)
+    void fillCell     (const QPoint& position);
+    void unfillCell   (const QPoint& position);
+    bool isFilledCell (const QPoint& position);
+
+    // Set and check weights methods
+    void setWeights       (const QString& weightMap);
+    void setWeightForCell (const QPoint& position, int value);
+    int  weightOfCell     (const QPoint& position);
+
+    // These operate on view cell (that has some concrete size)
+    void fillAtMP     (const QPoint& position);
+    void unfillAtMP   (const QPoint& position);
+    bool isFilledAtMP (const QPoint& position);
+
+    void fillRow    (int row);
+    void fillColumn (int column);
+    void fillVector (const QVector<QVector<int> >& vector);
+
+private:
+    // Heuristic of the A* queries, that don't ask for their own one.
+    Heuristic::Type defaultHeuristic () const;
+
+    // Logic representation
+    Grid m_grid;
+
+    // Search data is kept between the queries, so that the search doesn't allocate per-cell data every time.
+    mutable AStar                m_search;
+    mutable DistanceFieldCache   m_fields;
+    mutable FlowField            m_flowField;
+    mutable JumpPointSearch      m_jumpSearch;
+    mutable HierarchicalSearch   m_hierarchicalSearch;
+    mutable BidirectionalSearch  m_bidirectionalSearch;
+    mutable DStarLite            m_replanner;
+    mutable BatchSearch          m_batchSearch;
+    mutable CooperativeSearch    m_cooperativeSearch;
+    mutable SearchSpace          m_rangeSpace;
+    mutable ContractionHierarchy m_contraction;
+    mutable uint                 m_contractionVersion = 0;
+    SearchMode                   m_searchMode = SearchMode::GRID;
+    Landmarks                    m_landmarks;
+
+    // Default constants
+    static constexpr int MAX_WIDTH = 8192;
+    static constexpr int MAX_HEIGHT = 8192;
+    static constexpr int MAX_CELLSIZE = 64;
+
+    // Sizes
+    QSize m_mapSize;
+    uint                         m_cellSize;
+};
+
+#endif // MAP_H
@@ -1,46 +1,92 @@
-QT       += core gui xml
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++11
-
-# The following define makes your compiler emit warnings if you use
-# any Qt feature that has been marked deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    Graph/edge.cpp \
-    Graph/graph.cpp \
-    Graph/node.cpp \
-    Graph/tree.cpp \
-    Path/grid.cpp \
-    mapmodel.cpp \
-    main.cpp \
-    board.cpp \
-    mapview.cpp \
-    spritesheet.cpp \
-    tile.cpp
-
-HEADERS += \
-    Graph/edge.h \
-    Graph/graph.h \
-    Graph/node.h \
-    Graph/tree.h \
-    Path/grid.h \
-    mapmodel.h \
-    board.h \
-    mapview.h \
-    spritesheet.h \
-    tile.h
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+QT       += core gui xml
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++11
+
+# The following define makes your compiler emit warnings if you use
+# any Qt feature that has been marked deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    Graph/blockmap.cpp \
+    Graph/bucketqueue.cpp \
+    Graph/compactgraph.cpp \
+    Graph/contractionhierarchy.cpp \
+    Graph/edge.cpp \
+    Graph/graph.cpp \
+    Graph/node.cpp \
+    Graph/priorityqueue.cpp \
+    Graph/tree.cpp \
+    Path/astar.cpp \
+    Path/batchsearch.cpp \
+    Path/bidirectionalsearch.cpp \
+    Path/chunkstore.cpp \
+    Path/connectedcomponents.cpp \
+    Path/cooperativesearch.cpp \
+    Path/distancefield.cpp \
+    Path/distancefieldcache.cpp \
+    Path/dstarlite.cpp \
+    Path/flowfield.cpp \
+    Path/grid.cpp \
+    Path/heuristic.cpp \
+    Path/hierarchicalsearch.cpp \
+    Path/jumppointsearch.cpp \
+    Path/landmarks.cpp \
+    Path/movementrange.cpp \
+    Path/reservationtable.cpp \
+    Path/reversesearch.cpp \
+    Path/searchspace.cpp \
+    mapmodel.cpp \
+    main.cpp \
+    board.cpp \
+    mapview.cpp \
+    spritesheet.cpp \
+    tile.cpp
+
+HEADERS += \
+    Graph/blockmap.h \
+    Graph/bucketqueue.h \
+    Graph/compactgraph.h \
+    Graph/contractionhierarchy.h \
+    Graph/edge.h \
+    Graph/graph.h \
+    Graph/node.h \
+    Graph/priorityqueue.h \
+    Graph/tree.h \
+    Path/astar.h \
+    Path/batchsearch.h \
+    Path/bidirectionalsearch.h \
+    Path/chunkstore.h \
+    Path/connectedcomponents.h \
+    Path/cooperativesearch.h \
+    Path/distancefield.h \
+    Path/distancefieldcache.h \
+    Path/dstarlite.h \
+    Path/flowfield.h \
+    Path/grid.h \
+    Path/heuristic.h \
+    Path/hierarchicalsearch.h \
+    Path/jumppointsearch.h \
+    Path/landmarks.h \
+    Path/movementrange.h \
+    Path/reservationtable.h \
+    Path/reversesearch.h \
+    Path/searchspace.h \
+    mapmodel.h \
+    board.h \
+    mapview.h \
+    spritesheet.h \
+    tile.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target